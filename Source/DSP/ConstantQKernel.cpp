@@ -0,0 +1,114 @@
+//--------------------------------------------------------------------------------------------
+// Name: ConstantQKernel.cpp
+// Author: Jérémi Panneton
+// Creation date: October 16th, 2026
+//--------------------------------------------------------------------------------------------
+
+#include "ConstantQKernel.h"
+#include "Utilities/Math.h"
+
+namespace
+{
+    using ComplexDouble = std::complex<double>;
+
+    //----------------------------------------------------------------------------------------
+    /// Returns the sum of e^(i * theta * m) for m between 0 and size - 1 (Dirichlet kernel).
+    //----------------------------------------------------------------------------------------
+    ComplexDouble dirichlet(double theta, int size)
+    {
+        const double denominator = std::sin(theta / 2);
+        if (std::abs(denominator) < 1e-12)
+            return ComplexDouble(size);
+
+        return std::polar(std::sin(size * theta / 2) / denominator, theta * (size - 1) / 2);
+    }
+}
+
+void ConstantQKernel::build(const FrequencyAxis<float>& frequencyAxis, int fftSize, double sampleRate)
+{
+    m_matrix.clear();
+
+    const int resolution = frequencyAxis.getResolution();
+    const int fftBins = fftSize / 2;
+    jassert(resolution > 1);
+    m_products.resize(static_cast<size_t>(2 * resolution));
+
+    // Spectral kernel of the current frequency
+    std::vector<Complex> weights;
+
+    for (int k = 0; k < resolution; ++k)
+    {
+        // The bandwidth of a row is the spacing of the axis around its frequency
+        const double frequency = frequencyAxis[k];
+        const double spacing = k == 0 ? frequencyAxis[1] - frequencyAxis[0]
+                             : k == resolution - 1 ? frequencyAxis[k] - frequencyAxis[k - 1]
+                             : (frequencyAxis[k + 1] - frequencyAxis[k - 1]) / 2;
+
+        // Temporal kernel: Hann window of kernelSize samples centered in the frame, modulated at the row frequency.
+        // Its gain compensates for the window (mean of 0.5) and the negative frequencies, so that a sine of amplitude A gives A.
+        const int kernelSize = jlimit(static_cast<int>(minKernelSize), fftSize, roundToInt(sampleRate / jmax(spacing, 1e-3)));
+        const int kernelStart = (fftSize - kernelSize) / 2;
+        const double omega = 2 * pi<double> * frequency / sampleRate;
+        const double gain = 4.0 / kernelSize;
+
+        // Only keep the main lobe and the first side lobes of the spectral kernel
+        const double centerBin = frequency * fftSize / sampleRate;
+        const double halfWidth = static_cast<double>(lobeWidth) * fftSize / kernelSize + 1;
+        const int firstBin = jlimit(0, fftBins - 1, static_cast<int>(std::floor(centerBin - halfWidth)));
+        const int lastBin = jlimit(firstBin, fftBins - 1, static_cast<int>(std::ceil(centerBin + halfWidth)));
+
+        weights.clear();
+        for (int bin = firstBin; bin <= lastBin; ++bin)
+        {
+            // DFT of the temporal kernel at this bin (closed form of a Hann window: three Dirichlet kernels)
+            const double theta = omega - 2 * pi<double> * bin / fftSize;
+            const double windowStep = 2 * pi<double> / kernelSize;
+            const ComplexDouble window = 0.5 * dirichlet(theta, kernelSize)
+                                       - 0.25 * dirichlet(theta - windowStep, kernelSize)
+                                       - 0.25 * dirichlet(theta + windowStep, kernelSize);
+            const ComplexDouble shift = std::polar(1.0, -2 * pi<double> * bin * kernelStart / fftSize);
+
+            // Parseval: sum(x * conj(t)) = sum(X * conj(T)) / N
+            const ComplexDouble weight = std::conj(gain * shift * window) / static_cast<double>(fftSize);
+            weights.emplace_back(static_cast<float>(weight.real()), static_cast<float>(weight.imag()));
+        }
+
+        // Over the interleaved spectrum, Re(w * s) = wr * sr - wi * si and Im(w * s) = wi * sr + wr * si
+        m_matrix.beginRow(2 * firstBin);
+        for (const auto& weight : weights)
+        {
+            m_matrix.addWeight(weight.real());
+            m_matrix.addWeight(-weight.imag());
+        }
+
+        m_matrix.endRow(fftSize);
+
+        m_matrix.beginRow(2 * firstBin);
+        for (const auto& weight : weights)
+        {
+            m_matrix.addWeight(weight.imag());
+            m_matrix.addWeight(weight.real());
+        }
+
+        m_matrix.endRow(fftSize);
+    }
+}
+
+void ConstantQKernel::apply(const Complex* spectrum, float* magnitudes) noexcept
+{
+    // std::complex is laid out as its real part followed by its imaginary part
+    m_matrix.apply(reinterpret_cast<const float*>(spectrum), m_products.data());
+
+    const int numRows = getNumRows();
+    for (int row = 0; row < numRows; ++row)
+    {
+        const float real = m_products[2 * row];
+        const float imag = m_products[2 * row + 1];
+        magnitudes[row] = std::sqrt(real * real + imag * imag);
+    }
+}
+
+int ConstantQKernel::getNumRows() const noexcept
+{
+    return m_matrix.getNumRows() / 2;
+}
\ No newline at end of file
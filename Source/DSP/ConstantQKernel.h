@@ -0,0 +1,58 @@
+//--------------------------------------------------------------------------------------------
+// Name: ConstantQKernel.h
+// Author: Jérémi Panneton
+// Creation date: October 16th, 2026
+//--------------------------------------------------------------------------------------------
+
+#pragma once
+
+#include "JuceHeader.h"
+#include "SparseRowMatrix.h"
+#include "Utilities/FrequencyAxis.h"
+#include <vector>
+
+//--------------------------------------------------------------------------------------------
+/// Sparse spectral kernel of a constant-Q transform (Brown & Puckette).
+/// Each frequency of the axis gets its own Hann-windowed complex exponential, whose length matches
+/// the spacing of the axis around that frequency (long windows for the low end, short ones for the high end).
+/// The kernels are stored in the frequency domain, where they only cover a few bins, so a whole
+/// transform is a sparse product with the spectrum of a single FFT frame.
+/// The complex products are split into a real and an imaginary row of a SparseRowMatrix,
+/// applied to the interleaved real and imaginary parts of the spectrum.
+//--------------------------------------------------------------------------------------------
+class ConstantQKernel
+{
+public:
+    using Complex = dsp::Complex<float>;
+
+    enum
+    {
+        minKernelSize = 16,	// Shortest temporal kernel (in samples)
+        lobeWidth = 3		// Half-width of the kept part of each spectral kernel, in bins of the kernel's own resolution
+    };
+
+    //----------------------------------------------------------------------------------------
+    /// Computes the spectral kernel of every frequency of the axis. May allocate if the kernel is larger than the previous one.
+    /// @param[in] frequencyAxis			Frequency axis (one kernel for each frequency).
+    /// @param[in] fftSize					Size of the FFT frames the kernel is applied to.
+    /// @param[in] sampleRate				Sample rate of the analyzed signal.
+    //----------------------------------------------------------------------------------------
+    void build(const FrequencyAxis<float>& frequencyAxis, int fftSize, double sampleRate);
+
+    //----------------------------------------------------------------------------------------
+    /// Computes the constant-Q magnitudes of a spectrum.
+    /// A sine of amplitude A centered on a frequency of the axis gives a magnitude of A.
+    /// @param[in] spectrum					Positive frequencies of the FFT frame (fftSize / 2 values).
+    /// @param[out] magnitudes				Constant-Q magnitudes (one value for each frequency of the axis).
+    //----------------------------------------------------------------------------------------
+    void apply(const Complex* spectrum, float* magnitudes) noexcept;
+
+    //----------------------------------------------------------------------------------------
+    /// Returns the number of rows (frequencies of the axis).
+    //----------------------------------------------------------------------------------------
+    int getNumRows() const noexcept;
+
+private:
+    SparseRowMatrix m_matrix;				/// Conjugated spectral kernels: the real then the imaginary part of each frequency.
+    std::vector<float> m_products;			/// Real and imaginary parts of the product of each frequency.
+};
\ No newline at end of file
@@ -0,0 +1,102 @@
+//--------------------------------------------------------------------------------------------
+// Name: Decimator.cpp
+// Author: Jérémi Panneton
+// Creation date: October 16th, 2026
+//--------------------------------------------------------------------------------------------
+
+#include "Decimator.h"
+#include "Utilities/Math.h"
+#include <cstring>
+
+Decimator::Decimator(int numChannels, int maxFactor, int maxBlockSize)
+    : m_maxFactor(maxFactor)
+    , m_maxBlockSize(maxBlockSize)
+    , m_coefficients(tapsPerPhase * maxFactor + 1)
+    , m_history(numChannels, tapsPerPhase * maxFactor + maxBlockSize)
+{
+    setFactor(1);
+}
+
+void Decimator::setFactor(int factor)
+{
+    m_factor = jlimit(1, m_maxFactor, factor);
+
+    if (m_factor == 1)
+    {
+        m_numTaps = 1;
+        m_coefficients[0] = 1.0f;
+    }
+    else
+    {
+        // Windowed sinc with its cutoff at 80% of the decimated Nyquist frequency.
+        // The remaining band up to the decimated Nyquist frequency is used for the transition.
+        m_numTaps = tapsPerPhase * m_factor + 1;
+        const double cutoff = 0.8 * 0.5 / m_factor;
+        const double center = (m_numTaps - 1) / 2.0;
+
+        dsp::WindowingFunction<float>::fillWindowingTables(m_coefficients, static_cast<size_t>(m_numTaps), dsp::WindowingFunction<float>::blackman, false);
+
+        double sum = 0.0;
+        for (int i = 0; i < m_numTaps; ++i)
+        {
+            const double x = 2.0 * cutoff * (i - center);
+            const double sinc = x != 0.0 ? std::sin(pi<double> * x) / (pi<double> * x) : 1.0;
+            m_coefficients[i] *= static_cast<float>(2.0 * cutoff * sinc);
+            sum += m_coefficients[i];
+        }
+
+        // Unity gain at DC
+        FloatVectorOperations::multiply(m_coefficients, static_cast<float>(1.0 / sum), m_numTaps);
+    }
+
+    reset();
+}
+
+int Decimator::getFactor() const noexcept
+{
+    return m_factor;
+}
+
+void Decimator::reset()
+{
+    m_history.clear();
+    m_phase = 0;
+}
+
+int Decimator::process(const float* const* input, int numChannels, int numSamples, float* const* output)
+{
+    jassert(numSamples <= m_maxBlockSize);
+    jassert(numChannels <= m_history.getNumChannels());
+
+    const int historySize = m_numTaps - 1;
+    const float* coefficients = m_coefficients;
+    // Only the input samples that complete a period of the factor produce an output sample
+    const int firstOutput = m_factor - 1 - m_phase;
+    int numOutput = 0;
+
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        float* history = m_history.getWritePointer(channel);
+        FloatVectorOperations::copy(history + historySize, input[channel], numSamples);
+
+        numOutput = 0;
+        for (int i = firstOutput; i < numSamples; i += m_factor)
+        {
+            // The filter ending at input sample i starts at history + i
+            const float* samples = history + i;
+            float sum = 0.0f;
+            for (int tap = 0; tap < m_numTaps; ++tap)
+            {
+                sum += coefficients[tap] * samples[tap];
+            }
+
+            output[channel][numOutput++] = sum;
+        }
+
+        // Keep the samples needed by the next block
+        std::memmove(history, history + numSamples, sizeof(float) * static_cast<size_t>(historySize));
+    }
+
+    m_phase = (m_phase + numSamples) % m_factor;
+    return numOutput;
+}
\ No newline at end of file
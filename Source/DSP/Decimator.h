@@ -0,0 +1,69 @@
+//--------------------------------------------------------------------------------------------
+// Name: Decimator.h
+// Author: Jérémi Panneton
+// Creation date: October 16th, 2026
+//--------------------------------------------------------------------------------------------
+
+#pragma once
+
+#include "JuceHeader.h"
+
+//--------------------------------------------------------------------------------------------
+/// Polyphase FIR decimator. The signal is low-pass filtered and downsampled by an integer factor,
+/// but the filter is only evaluated for the samples that are kept.
+//--------------------------------------------------------------------------------------------
+class Decimator
+{
+public:
+    enum
+    {
+        tapsPerPhase = 16 // Number of filter taps for each unit of the decimation factor
+    };
+
+    //----------------------------------------------------------------------------------------
+    /// Constructor. Everything is preallocated, so changing the factor never allocates.
+    /// @param[in] numChannels				Number of channels.
+    /// @param[in] maxFactor				Maximum decimation factor.
+    /// @param[in] maxBlockSize				Maximum number of input samples processed at once.
+    //----------------------------------------------------------------------------------------
+    Decimator(int numChannels, int maxFactor, int maxBlockSize);
+
+    //----------------------------------------------------------------------------------------
+    /// Sets the decimation factor. The anti-aliasing filter is redesigned and the state is cleared.
+    /// @param[in] factor					Decimation factor (1 means no decimation). Gets clipped between 1 and maxFactor.
+    //----------------------------------------------------------------------------------------
+    void setFactor(int factor);
+
+    //----------------------------------------------------------------------------------------
+    /// Returns the current decimation factor.
+    //----------------------------------------------------------------------------------------
+    int getFactor() const noexcept;
+
+    //----------------------------------------------------------------------------------------
+    /// Clears the filter state.
+    //----------------------------------------------------------------------------------------
+    void reset();
+
+    //----------------------------------------------------------------------------------------
+    /// Filters and downsamples a block of samples.
+    /// @param[in] input					Input samples (one buffer for each channel).
+    /// @param[in] numChannels				Number of channels to process (the first ones). The state of the others gets outdated,
+    ///										so the decimator should be reset before processing them again.
+    /// @param[in] numSamples				Number of input samples. Should be less or equal to maxBlockSize.
+    /// @param[out] output					Output samples (one buffer for each channel). Should hold at least numSamples / factor + 1 samples.
+    /// @return								Number of output samples.
+    //----------------------------------------------------------------------------------------
+    int process(const float* const* input, int numChannels, int numSamples, float* const* output);
+
+private:
+    const int m_maxFactor;					/// Maximum decimation factor.
+    const int m_maxBlockSize;				/// Maximum number of input samples processed at once.
+    int m_factor = 1;						/// Decimation factor.
+    int m_numTaps = 1;						/// Number of taps of the anti-aliasing filter.
+    int m_phase = 0;						/// Number of input samples since the last output sample.
+
+    HeapBlock<float> m_coefficients;		/// Anti-aliasing filter (symmetric, so a convolution is a plain dot product).
+    AudioBuffer<float> m_history;			/// Last numTaps - 1 input samples of each channel, followed by the block being processed.
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Decimator)
+};
\ No newline at end of file
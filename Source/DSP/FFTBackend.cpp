@@ -0,0 +1,132 @@
+//--------------------------------------------------------------------------------------------
+// Name: FFTBackend.cpp
+// Author: Jérémi Panneton
+// Creation date: October 16th, 2026
+//--------------------------------------------------------------------------------------------
+
+#include "FFTBackend.h"
+#include "RadixFFT.h"
+#include <map>
+
+namespace
+{
+    constexpr int numBenchmarkRuns = 5;				// The shortest run is kept, to ignore preemptions
+    constexpr int benchmarkSamplesPerRun = 1 << 16;	// Each run transforms at least this many values
+
+    //----------------------------------------------------------------------------------------
+    /// Backend using dsp::FFT.
+    //----------------------------------------------------------------------------------------
+    class JuceBackend : public FFTBackend
+    {
+    public:
+        JuceBackend(int order) : m_fft(order) {}
+
+        void perform(const Complex* input, Complex* output) noexcept override
+        {
+            m_fft.perform(input, output, false);
+        }
+
+        const char* getName() const noexcept override
+        {
+            return "JUCE";
+        }
+
+    private:
+        dsp::FFT m_fft;
+    };
+
+    //----------------------------------------------------------------------------------------
+    /// Backend using RadixFFT.
+    //----------------------------------------------------------------------------------------
+    class RadixBackend : public FFTBackend
+    {
+    public:
+        RadixBackend(int order) : m_fft(order) {}
+
+        void perform(const Complex* input, Complex* output) noexcept override
+        {
+            m_fft.perform(input, output);
+        }
+
+        const char* getName() const noexcept override
+        {
+            return "Radix-4";
+        }
+
+    private:
+        RadixFFT m_fft;
+    };
+}
+
+std::unique_ptr<FFTBackend> FFTBackend::create(Type type, int order)
+{
+    switch (type)
+    {
+        case Type::JUCE:
+            return std::make_unique<JuceBackend>(order);
+
+        case Type::Radix:
+            return std::make_unique<RadixBackend>(order);
+
+        case Type::Fastest:
+        default:
+            return create(getFastestType(order), order);
+    }
+}
+
+FFTBackend::Type FFTBackend::getFastestType(int order)
+{
+    // Every analyzer asks for the same orders, so they're only measured by the first one
+    static CriticalSection lock;
+    static std::map<int, Type> fastestTypes;
+
+    const ScopedLock scopedLock(lock);
+    const auto found = fastestTypes.find(order);
+    if (found != fastestTypes.end())
+        return found->second;
+
+    auto juceBackend = create(Type::JUCE, order);
+    auto radixBackend = create(Type::Radix, order);
+    const double juceTime = measure(*juceBackend, order);
+    const double radixTime = measure(*radixBackend, order);
+    const Type fastestType = radixTime < juceTime ? Type::Radix : Type::JUCE;
+
+    Logger::writeToLog("FFT order " + String(order) + ": " + String(fastestType == Type::Radix ? radixBackend->getName() : juceBackend->getName())
+                       + " backend selected (JUCE: " + String(juceTime * 1.0e6, 2) + " us, Radix-4: " + String(radixTime * 1.0e6, 2) + " us)");
+
+    fastestTypes[order] = fastestType;
+    return fastestType;
+}
+
+double FFTBackend::measure(FFTBackend& backend, int order)
+{
+    const int size = 1 << order;
+    const int numTransforms = jmax(1, benchmarkSamplesPerRun / size);
+
+    HeapBlock<Complex> input(static_cast<size_t>(size));
+    HeapBlock<Complex> output(static_cast<size_t>(size));
+
+    Random random(order);
+    for (int i = 0; i < size; ++i)
+    {
+        input[i] = { random.nextFloat() - 0.5f, random.nextFloat() - 0.5f };
+    }
+
+    // The first transform warms up the caches
+    backend.perform(input, output);
+
+    double shortestTime = std::numeric_limits<double>::max();
+    for (int run = 0; run < numBenchmarkRuns; ++run)
+    {
+        const int64 start = Time::getHighResolutionTicks();
+        for (int i = 0; i < numTransforms; ++i)
+        {
+            backend.perform(input, output);
+        }
+
+        const double time = Time::highResolutionTicksToSeconds(Time::getHighResolutionTicks() - start);
+        shortestTime = jmin(shortestTime, time / numTransforms);
+    }
+
+    return shortestTime;
+}
\ No newline at end of file
@@ -0,0 +1,73 @@
+//--------------------------------------------------------------------------------------------
+// Name: FFTBackend.h
+// Author: Jérémi Panneton
+// Creation date: October 16th, 2026
+//--------------------------------------------------------------------------------------------
+
+#pragma once
+
+#include "JuceHeader.h"
+#include <memory>
+
+//--------------------------------------------------------------------------------------------
+/// Forward complex FFT of a fixed power of 2 size, behind which several implementations can be swapped.
+/// The fastest implementation depends on the size and on the machine, so it can be picked with a micro-benchmark.
+//--------------------------------------------------------------------------------------------
+class FFTBackend
+{
+public:
+    using Complex = dsp::Complex<float>;
+
+    //----------------------------------------------------------------------------------------
+    /// Defines which implementation performs the transforms.
+    //----------------------------------------------------------------------------------------
+    enum class Type
+    {
+        JUCE,		/// dsp::FFT (uses the fastest engine JUCE was built with).
+        Radix,		/// RadixFFT (Stockham radix 4, with SSE butterflies).
+        Fastest		/// Whichever of the above is the fastest for the requested order on this machine, measured at creation.
+    };
+
+    //----------------------------------------------------------------------------------------
+    /// Destructor.
+    //----------------------------------------------------------------------------------------
+    virtual ~FFTBackend() = default;
+
+    //----------------------------------------------------------------------------------------
+    /// Performs the forward transform (not normalized).
+    /// @param[in] input					Input values (size values).
+    /// @param[out] output					Transformed values (size values). Should not be the same buffer as input.
+    //----------------------------------------------------------------------------------------
+    virtual void perform(const Complex* input, Complex* output) noexcept = 0;
+
+    //----------------------------------------------------------------------------------------
+    /// Returns the name of the implementation.
+    //----------------------------------------------------------------------------------------
+    virtual const char* getName() const noexcept = 0;
+
+    //----------------------------------------------------------------------------------------
+    /// Creates a backend. Allocates, so it should not be called from a real-time thread.
+    /// @param[in] type						Implementation to create. Fastest runs a short benchmark of every implementation (a few ms for the large orders)
+    ///										the first time an order is requested, and reuses its choice afterwards.
+    /// @param[in] order					FFT order (size = 2 ^ order).
+    /// @return								Created backend.
+    //----------------------------------------------------------------------------------------
+    static std::unique_ptr<FFTBackend> create(Type type, int order);
+
+private:
+    //----------------------------------------------------------------------------------------
+    /// Returns the fastest implementation for an order. Each order is only measured once per process,
+    /// and the choice is written to the log. Can be called from any thread.
+    /// @param[in] order					FFT order (size = 2 ^ order).
+    /// @return								JUCE or Radix.
+    //----------------------------------------------------------------------------------------
+    static Type getFastestType(int order);
+
+    //----------------------------------------------------------------------------------------
+    /// Measures the time a backend takes to perform a transform.
+    /// @param[in] backend					Backend to measure.
+    /// @param[in] order					FFT order of the backend.
+    /// @return								Shortest time of a few runs, in seconds per transform.
+    //----------------------------------------------------------------------------------------
+    static double measure(FFTBackend& backend, int order);
+};
\ No newline at end of file
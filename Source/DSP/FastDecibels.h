@@ -0,0 +1,104 @@
+//--------------------------------------------------------------------------------------------
+// Name: FastDecibels.h
+// Author: Jérémi Panneton
+// Creation date: October 16th, 2026
+//--------------------------------------------------------------------------------------------
+
+#pragma once
+
+#include "JuceHeader.h"
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+ #include <emmintrin.h>
+ #define FAST_DECIBELS_USE_SSE 1
+#endif
+
+// Minimax polynomial of log2(m) / (m - 1) for a mantissa m in [1, 2).
+// The absolute error of log2 stays below 6e-5, which is less than 0.0004 dB.
+namespace FastLog2Coefficients
+{
+    constexpr float c0 = 2.8882704548f;
+    constexpr float c1 = -2.5207496258f;
+    constexpr float c2 = 1.4811664752f;
+    constexpr float c3 = -0.4657256443f;
+    constexpr float c4 = 0.0596515483f;
+}
+
+//--------------------------------------------------------------------------------------------
+/// Approximates the base 2 logarithm by splitting the exponent from the mantissa.
+/// @param[in] x							Value to convert. Should be a positive normal number.
+/// @return									Approximated logarithm (absolute error below 6e-5).
+//--------------------------------------------------------------------------------------------
+inline float fastLog2(float x) noexcept
+{
+    using namespace FastLog2Coefficients;
+
+    uint32 bits;
+    std::memcpy(&bits, &x, sizeof(bits));
+    const float exponent = static_cast<float>(static_cast<int>(bits >> 23) - 127);
+
+    // Force the exponent to 0 to keep the mantissa only (between 1 and 2)
+    bits = (bits & 0x007fffff) | 0x3f800000;
+    float mantissa;
+    std::memcpy(&mantissa, &bits, sizeof(mantissa));
+
+    const float polynomial = (((c4 * mantissa + c3) * mantissa + c2) * mantissa + c1) * mantissa + c0;
+    return polynomial * (mantissa - 1.0f) + exponent;
+}
+
+#if FAST_DECIBELS_USE_SSE
+//--------------------------------------------------------------------------------------------
+/// Approximates the base 2 logarithm of four values at once (same approximation as the scalar version).
+/// @param[in] x							Values to convert. Should be positive normal numbers.
+/// @return									Approximated logarithms (absolute error below 6e-5).
+//--------------------------------------------------------------------------------------------
+inline __m128 fastLog2(__m128 x) noexcept
+{
+    using namespace FastLog2Coefficients;
+
+    const __m128i bits = _mm_castps_si128(x);
+    const __m128 exponent = _mm_cvtepi32_ps(_mm_sub_epi32(_mm_srli_epi32(bits, 23), _mm_set1_epi32(127)));
+    const __m128 mantissa = _mm_castsi128_ps(_mm_or_si128(_mm_and_si128(bits, _mm_set1_epi32(0x007fffff)), _mm_set1_epi32(0x3f800000)));
+
+    __m128 polynomial = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(c4), mantissa), _mm_set1_ps(c3));
+    polynomial = _mm_add_ps(_mm_mul_ps(polynomial, mantissa), _mm_set1_ps(c2));
+    polynomial = _mm_add_ps(_mm_mul_ps(polynomial, mantissa), _mm_set1_ps(c1));
+    polynomial = _mm_add_ps(_mm_mul_ps(polynomial, mantissa), _mm_set1_ps(c0));
+
+    return _mm_add_ps(_mm_mul_ps(polynomial, _mm_sub_ps(mantissa, _mm_set1_ps(1.0f))), exponent);
+}
+#endif
+
+//--------------------------------------------------------------------------------------------
+/// Converts gains to decibels in a single pass, like Decibels::gainToDecibels but with fastLog2.
+/// @param[in] gains						Gains to convert.
+/// @param[out] decibels					Converted levels in dB. Can be the same buffer as gains.
+/// @param[in] numValues					Number of values to convert.
+/// @param[in] minusInfinityDb				Level in dB returned for a gain of 0 (or any gain below this level).
+//--------------------------------------------------------------------------------------------
+inline void gainsToDecibels(const float* gains, float* decibels, int numValues, float minusInfinityDb = -100.0f) noexcept
+{
+    // 20 * log10(x) = 20 * log10(2) * log2(x)
+    constexpr float log2ToDecibels = 6.0205999133f;
+    const float minGain = Decibels::decibelsToGain(minusInfinityDb, minusInfinityDb - 1.0f);
+    int i = 0;
+
+#if FAST_DECIBELS_USE_SSE
+    const __m128 minGainVector = _mm_set1_ps(minGain);
+    const __m128 minDecibelsVector = _mm_set1_ps(minusInfinityDb);
+    const __m128 log2ToDecibelsVector = _mm_set1_ps(log2ToDecibels);
+
+    for (; i + 4 <= numValues; i += 4)
+    {
+        // Clamping to the minimum gain also gets rid of zeros and denormals
+        const __m128 log2 = fastLog2(_mm_max_ps(_mm_loadu_ps(gains + i), minGainVector));
+        _mm_storeu_ps(decibels + i, _mm_max_ps(_mm_mul_ps(log2, log2ToDecibelsVector), minDecibelsVector));
+    }
+#endif
+
+    for (; i < numValues; ++i)
+    {
+        decibels[i] = jmax(log2ToDecibels * fastLog2(jmax(gains[i], minGain)), minusInfinityDb);
+    }
+}
\ No newline at end of file
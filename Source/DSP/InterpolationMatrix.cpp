@@ -0,0 +1,96 @@
+//--------------------------------------------------------------------------------------------
+// Name: InterpolationMatrix.cpp
+// Author: Jérémi Panneton
+// Creation date: October 16th, 2026
+//--------------------------------------------------------------------------------------------
+
+#include "InterpolationMatrix.h"
+#include "Filters.h"
+
+namespace
+{
+    // A row holds at most one weight for each tap of the largest kernel, plus its padding
+    constexpr int maxRowSize = (2 * InterpolationMatrix::lanczosFilterSize + SparseRowMatrix::rowAlignment - 1)
+                             / SparseRowMatrix::rowAlignment * SparseRowMatrix::rowAlignment;
+}
+
+InterpolationMatrix::InterpolationMatrix(int maxRows)
+    : m_matrix(maxRows, maxRows * maxRowSize)
+{
+}
+
+void InterpolationMatrix::build(const FrequencyAxis<float>& frequencyAxis, int fftBins, double sampleRate, Mode mode)
+{
+    m_matrix.clear();
+
+    const float nyquistFrequency = static_cast<float>(sampleRate) / 2;
+    // Bin k is centered on k * sampleRate / fftSize, with fftSize = 2 * fftBins
+    const float freqToBin = fftBins / nyquistFrequency;
+    const double fftBinWidth = 1.0 / fftBins;
+
+    for (int x = 0; x < frequencyAxis.getResolution() - 1; ++x)
+    {
+        // Stop at the first frequency that spans more than one bin
+        const double freqBinWidth = (frequencyAxis[x + 1] - frequencyAxis[x]) / nyquistFrequency;
+        if (freqBinWidth > fftBinWidth)
+            break;
+
+        const float position = frequencyAxis[x] * freqToBin;
+
+        switch (mode)
+        {
+        case Mode::None:
+        {
+            // + 0.5 to centerly space bins
+            m_matrix.beginRow(jlimit(0, fftBins - 1, static_cast<int>(position + 0.5f)));
+            m_matrix.addWeight(1.0f);
+            break;
+        }
+        case Mode::Linear:
+        {
+            const int x1 = static_cast<int>(position);
+            const int x2 = std::min(fftBins - 1, x1 + 1);
+            const float frac = position - x1;
+
+            m_matrix.beginRow(x1);
+            if (x2 != x1)
+            {
+                m_matrix.addWeight(1.0f - frac);
+                m_matrix.addWeight(frac);
+            }
+            else
+            {
+                // Last bin: both weights fall on it
+                m_matrix.addWeight(1.0f);
+            }
+            break;
+        }
+        case Mode::Lanczos:
+        {
+            // Only the taps that fall inside the spectrum contribute
+            const int start = static_cast<int>(floorToNInf(position));
+            const int firstBin = std::max(0, start - lanczosFilterSize + 1);
+            const int lastBin = std::min(fftBins - 1, start + lanczosFilterSize);
+
+            m_matrix.beginRow(firstBin);
+            for (int i = firstBin; i <= lastBin; ++i)
+            {
+                m_matrix.addWeight(lanczosKernel(position - i, lanczosFilterSize));
+            }
+            break;
+        }
+        }
+
+        m_matrix.endRow(fftBins);
+    }
+}
+
+void InterpolationMatrix::apply(const float* inputData, float* outputData) const noexcept
+{
+    m_matrix.apply(inputData, outputData);
+}
+
+int InterpolationMatrix::getNumRows() const noexcept
+{
+    return m_matrix.getNumRows();
+}
\ No newline at end of file
@@ -0,0 +1,64 @@
+//--------------------------------------------------------------------------------------------
+// Name: InterpolationMatrix.h
+// Author: Jérémi Panneton
+// Creation date: October 16th, 2026
+//--------------------------------------------------------------------------------------------
+
+#pragma once
+
+#include "JuceHeader.h"
+#include "SparseRowMatrix.h"
+#include "Utilities/FrequencyAxis.h"
+
+//--------------------------------------------------------------------------------------------
+/// Sparse matrix holding the interpolation weights that map FFT bins to the lower frequencies of an axis.
+/// The weights only depend on the axis layout and the number of bins, so they are computed once
+/// and the per-frame interpolation becomes a sparse matrix-vector product.
+/// The taps of a kernel are contiguous bins, so the weights are held by a SparseRowMatrix.
+//--------------------------------------------------------------------------------------------
+class InterpolationMatrix
+{
+public:
+    enum class Mode
+    {
+        None,	/// Nearest bin.
+        Linear,	/// Linear interpolation between the two closest bins.
+        Lanczos	/// Lanczos interpolation.
+    };
+
+    enum
+    {
+        lanczosFilterSize = 5
+    };
+
+    //----------------------------------------------------------------------------------------
+    /// Constructor. Preallocates the matrix, so that rebuilding it never allocates.
+    /// @param[in] maxRows					Maximum number of rows (resolution of the frequency axis).
+    //----------------------------------------------------------------------------------------
+    InterpolationMatrix(int maxRows);
+
+    //----------------------------------------------------------------------------------------
+    /// Computes the weights of every frequency that is more finely resolved by the axis than by the FFT.
+    /// The other (higher) frequencies cover more than one bin and are left to the caller.
+    /// @param[in] frequencyAxis			Frequency axis to map the bins to.
+    /// @param[in] fftBins					Number of FFT bins.
+    /// @param[in] sampleRate				Sample rate.
+    /// @param[in] mode						Interpolation mode.
+    //----------------------------------------------------------------------------------------
+    void build(const FrequencyAxis<float>& frequencyAxis, int fftBins, double sampleRate, Mode mode);
+
+    //----------------------------------------------------------------------------------------
+    /// Interpolates the FFT bins over the rows of the matrix.
+    /// @param[in] inputData				FFT output (fftBins values).
+    /// @param[out] outputData				Interpolated data (one value for each row).
+    //----------------------------------------------------------------------------------------
+    void apply(const float* inputData, float* outputData) const noexcept;
+
+    //----------------------------------------------------------------------------------------
+    /// Returns the number of rows, which is the index of the first frequency not covered by the matrix.
+    //----------------------------------------------------------------------------------------
+    int getNumRows() const noexcept;
+
+private:
+    SparseRowMatrix m_matrix;				/// Interpolation weights of each row, over the FFT bins.
+};
\ No newline at end of file
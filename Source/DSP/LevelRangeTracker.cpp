@@ -0,0 +1,138 @@
+//--------------------------------------------------------------------------------------------
+// Name: LevelRangeTracker.cpp
+// Author: Jérémi Panneton
+// Creation date: October 16th, 2026
+//--------------------------------------------------------------------------------------------
+
+#include "LevelRangeTracker.h"
+
+// Out-of-class definitions, since jlimit takes its bounds by reference
+constexpr float LevelRangeTracker::minLevel;
+constexpr float LevelRangeTracker::maxLevel;
+
+namespace
+{
+    constexpr double floorSmoothingTime = 200.0;	// Time constant of the floor candidate in milliseconds
+    constexpr double subWindowDuration = 500.0;		// The floor forgets a quieter passage after numSubWindows times this duration
+    constexpr double histogramTime = 1000.0;		// Time constant of the recent histogram in milliseconds
+    constexpr double peakSmoothingTime = 100.0;		// Hides the steps of the histogram bins
+
+    float getSmoothingCoefficient(double time, double frameDuration)
+    {
+        return frameDuration > 0.0 ? static_cast<float>(1.0 - std::exp(-frameDuration / time)) : 1.0f;
+    }
+}
+
+LevelRangeTracker::LevelRangeTracker(int numChannels)
+    : m_channels(static_cast<size_t>(numChannels))
+{
+    reset();
+}
+
+void LevelRangeTracker::setFrameDuration(double duration)
+{
+    if (duration != m_frameDuration)
+    {
+        m_frameDuration = duration;
+        m_floorCoefficient = getSmoothingCoefficient(floorSmoothingTime, duration);
+        m_peakCoefficient = getSmoothingCoefficient(peakSmoothingTime, duration);
+        m_histogramDecay = 1.0f - getSmoothingCoefficient(histogramTime, duration);
+    }
+}
+
+void LevelRangeTracker::reset() noexcept
+{
+    for (auto& state : m_channels)
+    {
+        FloatVectorOperations::clear(state.recentCounts, numLevels);
+        state.initialized = false;
+    }
+}
+
+Range<float> LevelRangeTracker::process(int channel, const float* levels, int numValues) noexcept
+{
+    jassert(channel >= 0 && channel < static_cast<int>(m_channels.size()));
+    jassert(numValues > 0);
+    auto& state = m_channels[static_cast<size_t>(channel)];
+
+    // Count the frame (the levels are clamped to the histogram)
+    FloatVectorOperations::clear(state.frameCounts, numLevels);
+    for (int i = 0; i < numValues; ++i)
+    {
+        const int index = static_cast<int>((jlimit(minLevel, maxLevel, levels[i]) - minLevel) * (1.0f / levelStep) + 0.5f);
+        state.frameCounts[index] += 1.0f;
+    }
+
+    FloatVectorOperations::multiply(state.recentCounts, m_histogramDecay, numLevels);
+    FloatVectorOperations::add(state.recentCounts, state.frameCounts, numLevels);
+
+    const float floorCandidate = findPercentile(state.frameCounts, noiseFloorPercentile);
+    // A louder frame raises the peak at once, the recent histogram lowers it slowly
+    const float peak = jmax(findPercentile(state.frameCounts, peakPercentile), findPercentile(state.recentCounts, peakPercentile));
+
+    if (!state.initialized)
+    {
+        state.smoothedFloor = floorCandidate;
+        state.smoothedPeak = peak;
+        state.currentMinimum = floorCandidate;
+        FloatVectorOperations::fill(state.subWindowMinima, floorCandidate, numSubWindows);
+        state.subWindowIndex = 0;
+        state.subWindowElapsed = 0.0;
+        state.initialized = true;
+    }
+    else
+    {
+        state.smoothedFloor += m_floorCoefficient * (floorCandidate - state.smoothedFloor);
+        state.smoothedPeak += m_peakCoefficient * (peak - state.smoothedPeak);
+        state.currentMinimum = jmin(state.currentMinimum, state.smoothedFloor);
+    }
+
+    // Minimum statistics: once a sub-window is over, its minimum replaces the oldest one
+    state.subWindowElapsed += m_frameDuration;
+    if (state.subWindowElapsed >= subWindowDuration)
+    {
+        state.subWindowMinima[state.subWindowIndex] = state.currentMinimum;
+        state.subWindowIndex = (state.subWindowIndex + 1) % numSubWindows;
+        state.currentMinimum = state.smoothedFloor;
+        state.subWindowElapsed = 0.0;
+    }
+
+    float noiseFloor = state.currentMinimum;
+    for (float minimum : state.subWindowMinima)
+        noiseFloor = jmin(noiseFloor, minimum);
+
+    return { noiseFloor, jmax(state.smoothedPeak, noiseFloor + minRange) };
+}
+
+float LevelRangeTracker::findPercentile(const float* counts, float ratio) noexcept
+{
+    float total = 0.0f;
+    for (int i = 0; i < numLevels; ++i)
+        total += counts[i];
+
+    // Walk from the closest end of the histogram
+    if (ratio <= 0.5f)
+    {
+        const float target = ratio * total;
+        float sum = 0.0f;
+        for (int i = 0; i < numLevels; ++i)
+        {
+            sum += counts[i];
+            if (sum > target)
+                return minLevel + i * levelStep;
+        }
+    }
+    else
+    {
+        const float target = (1.0f - ratio) * total;
+        float sum = 0.0f;
+        for (int i = numLevels - 1; i >= 0; --i)
+        {
+            sum += counts[i];
+            if (sum > target)
+                return minLevel + i * levelStep;
+        }
+    }
+
+    return minLevel;
+}
\ No newline at end of file
@@ -0,0 +1,99 @@
+//--------------------------------------------------------------------------------------------
+// Name: LevelRangeTracker.h
+// Author: Jérémi Panneton
+// Creation date: October 16th, 2026
+//--------------------------------------------------------------------------------------------
+
+#pragma once
+
+#include "JuceHeader.h"
+
+//--------------------------------------------------------------------------------------------
+/// Tracks a stable level range (noise floor and peak) over consecutive frames of levels in dB, for the adaptive level mode.
+/// Every frame is counted in a histogram of levels, so no value ever gets sorted:
+/// - the noise floor follows the minimum statistics of a low percentile of each frame. The percentile is smoothed over
+///   time, and its minimum over a sliding window (a few sub-windows) is kept, so the floor drops at once but only rises
+///   once the quieter frames have left the window.
+/// - the peak is a high percentile of an exponentially decaying histogram of the recent frames, so a few loud values
+///   don't flatten the rest of the range. The same percentile of the current frame lets it rise at once.
+/// Each frame costs O(1) per value, plus O(1) per histogram bin. All the memory is allocated at construction.
+//--------------------------------------------------------------------------------------------
+class LevelRangeTracker
+{
+public:
+    static constexpr float minLevel = -100.0f;				/// Lowest level of the histograms in dB (also the level of silent values).
+    static constexpr float maxLevel = 30.0f;				/// Highest level of the histograms in dB.
+    static constexpr float levelStep = 0.5f;				/// Width of a histogram bin in dB.
+    static constexpr float noiseFloorPercentile = 0.2f;		/// Ratio of the values of a frame below its noise floor candidate.
+    static constexpr float peakPercentile = 0.995f;			/// Ratio of the recent values below the peak.
+    static constexpr float minRange = 20.0f;				/// Minimum distance between the noise floor and the peak in dB.
+
+    enum
+    {
+        numSubWindows = 4
+    };
+
+    //----------------------------------------------------------------------------------------
+    /// Constructor.
+    /// @param[in] numChannels				Maximum number of tracked channels.
+    //----------------------------------------------------------------------------------------
+    LevelRangeTracker(int numChannels);
+
+    //----------------------------------------------------------------------------------------
+    /// Sets the time between two consecutive frames, which the time constants are based on.
+    /// @param[in] duration					Frame duration (hop size) in milliseconds.
+    //----------------------------------------------------------------------------------------
+    void setFrameDuration(double duration);
+
+    //----------------------------------------------------------------------------------------
+    /// Forgets the previous frames. The next frame sets the range on its own.
+    //----------------------------------------------------------------------------------------
+    void reset() noexcept;
+
+    //----------------------------------------------------------------------------------------
+    /// Adds a frame to the statistics of the specified channel.
+    /// @param[in] channel					Tracked channel.
+    /// @param[in] levels					Levels of the frame in dB.
+    /// @param[in] numValues				Number of levels in the frame.
+    /// @return								Noise floor and peak in dB, at least minRange apart.
+    //----------------------------------------------------------------------------------------
+    Range<float> process(int channel, const float* levels, int numValues) noexcept;
+
+private:
+    enum
+    {
+        numLevels = static_cast<int>((maxLevel - minLevel) / levelStep) + 1
+    };
+
+    //----------------------------------------------------------------------------------------
+    /// Statistics of one channel.
+    //----------------------------------------------------------------------------------------
+    struct ChannelState
+    {
+        float frameCounts[numLevels];		/// Histogram of the current frame.
+        float recentCounts[numLevels];		/// Exponentially decaying histogram of the recent frames.
+        float subWindowMinima[numSubWindows]; /// Minimum of the smoothed floor candidate during each of the last sub-windows.
+        float currentMinimum = 0.0f;		/// Minimum of the smoothed floor candidate during the current sub-window.
+        int subWindowIndex = 0;				/// Index of the oldest sub-window.
+        double subWindowElapsed = 0.0;		/// Time elapsed in the current sub-window in milliseconds.
+        float smoothedFloor = 0.0f;			/// Smoothed floor candidate in dB.
+        float smoothedPeak = 0.0f;			/// Smoothed peak in dB.
+        bool initialized = false;			/// False until the first frame is processed.
+    };
+
+    //----------------------------------------------------------------------------------------
+    /// Returns the level below which lies a given ratio of the counted values.
+    /// @param[in] counts					Histogram of the levels.
+    /// @param[in] ratio					Ratio of the values (between 0 and 1).
+    /// @return								Level in dB (center of the histogram bin reaching the ratio).
+    //----------------------------------------------------------------------------------------
+    static float findPercentile(const float* counts, float ratio) noexcept;
+
+    std::vector<ChannelState> m_channels;	/// Statistics of each channel.
+    double m_frameDuration = 0.0;			/// Time between two consecutive frames in milliseconds.
+    float m_floorCoefficient = 1.0f;		/// Smoothing coefficient of the floor candidate.
+    float m_peakCoefficient = 1.0f;			/// Smoothing coefficient of the peak.
+    float m_histogramDecay = 0.0f;			/// Weight kept by the recent histogram at each frame.
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LevelRangeTracker)
+};
\ No newline at end of file
@@ -0,0 +1,169 @@
+//--------------------------------------------------------------------------------------------
+// Name: PartialTracker.cpp
+// Author: Jérémi Panneton
+// Creation date: October 16th, 2026
+//--------------------------------------------------------------------------------------------
+
+#include "PartialTracker.h"
+
+namespace
+{
+    constexpr float minPeakLevel = -80.0f;		// Quieter peaks are considered as noise (dB)
+    constexpr float maxDeviation = 1.0f / 12;	// Largest frequency jump of a track between two frames (octaves)
+}
+
+PartialTracker::PartialTracker()
+{
+    reset();
+}
+
+void PartialTracker::reset() noexcept
+{
+    m_numPeaks = 0;
+    m_numTracks = 0;
+}
+
+void PartialTracker::process(const float* dbLevels, const float* frequencies, int numValues, PartialTracks& tracks) noexcept
+{
+    detectPeaks(dbLevels, frequencies, numValues);
+    linkPeaks();
+
+    // The peaks are sorted, so the tracks come out from the loudest to the quietest
+    tracks.numTracks = 0;
+    for (int peak = 0; peak < m_numPeaks; ++peak)
+    {
+        const int track = m_peakTracks[peak];
+        if (track < 0)
+            continue;
+
+        const int i = tracks.numTracks++;
+        tracks.ids[i] = m_trackIds[track];
+        tracks.frequencies[i] = m_trackFrequencies[track];
+        tracks.levels[i] = m_trackLevels[track];
+        tracks.ages[i] = m_trackAges[track];
+    }
+}
+
+void PartialTracker::detectPeaks(const float* dbLevels, const float* frequencies, int numValues) noexcept
+{
+    m_numPeaks = 0;
+
+    for (int i = 1; i < numValues - 1; ++i)
+    {
+        const float level = dbLevels[i];
+        if (level < minPeakLevel || level <= dbLevels[i - 1] || level < dbLevels[i + 1])
+            continue;
+
+        // Skip the peaks quieter than the quietest one kept, once the list is full
+        if (m_numPeaks == maxPeaks && level <= m_peakLevels[maxPeaks - 1])
+            continue;
+
+        // Parabola going through the three levels: its vertex is offset by delta (between -0.5 and 0.5 value)
+        const float previous = dbLevels[i - 1];
+        const float next = dbLevels[i + 1];
+        const float curvature = previous - 2.0f * level + next;
+        const float delta = curvature < 0.0f ? jlimit(-0.5f, 0.5f, 0.5f * (previous - next) / curvature) : 0.0f;
+        const float peakLevel = level - 0.25f * (previous - next) * delta;
+
+        // The frequencies don't have to be evenly spaced, so the offset is scaled by the spacing on its side
+        const float spacing = delta >= 0.0f ? frequencies[i + 1] - frequencies[i] : frequencies[i] - frequencies[i - 1];
+        const float peakFrequency = frequencies[i] + delta * spacing;
+
+        // Insertion in the sorted list (the quietest peak is dropped when the list is full)
+        int position = jmin(m_numPeaks, static_cast<int>(maxPeaks) - 1);
+        while (position > 0 && m_peakLevels[position - 1] < peakLevel)
+        {
+            m_peakLevels[position] = m_peakLevels[position - 1];
+            m_peakFrequencies[position] = m_peakFrequencies[position - 1];
+            --position;
+        }
+
+        m_peakLevels[position] = peakLevel;
+        m_peakFrequencies[position] = peakFrequency;
+        m_numPeaks = jmin(m_numPeaks + 1, static_cast<int>(maxPeaks));
+    }
+}
+
+void PartialTracker::linkPeaks() noexcept
+{
+    std::array<bool, PartialTracks::maxTracks> trackMatched {};
+    std::array<float, PartialTracks::maxTracks> trackLogFrequencies;
+    for (int track = 0; track < m_numTracks; ++track)
+    {
+        trackLogFrequencies[track] = std::log2(m_trackFrequencies[track]);
+    }
+
+    // 1- Each peak continues the closest free track, if it's close enough
+    for (int peak = 0; peak < m_numPeaks; ++peak)
+    {
+        const float peakLogFrequency = std::log2(m_peakFrequencies[peak]);
+        float closestDistance = maxDeviation;
+        int closestTrack = -1;
+
+        for (int track = 0; track < m_numTracks; ++track)
+        {
+            const float distance = std::abs(trackLogFrequencies[track] - peakLogFrequency);
+            if (!trackMatched[track] && distance < closestDistance)
+            {
+                closestDistance = distance;
+                closestTrack = track;
+            }
+        }
+
+        m_peakTracks[peak] = closestTrack;
+        if (closestTrack >= 0)
+        {
+            trackMatched[closestTrack] = true;
+            m_trackFrequencies[closestTrack] = m_peakFrequencies[peak];
+            m_trackLevels[closestTrack] = m_peakLevels[peak];
+            m_missedFrames[closestTrack] = 0;
+            ++m_trackAges[closestTrack];
+        }
+    }
+
+    // 2- Tracks without any peak are held for a few frames before being released
+    for (int track = m_numTracks - 1; track >= 0; --track)
+    {
+        if (!trackMatched[track] && ++m_missedFrames[track] > maxMissedFrames)
+        {
+            // The last track (matched or not) moves into this slot
+            trackMatched[track] = trackMatched[m_numTracks - 1];
+            removeTrack(track);
+        }
+    }
+
+    // 3- The remaining peaks start new tracks, as long as the pool isn't full
+    for (int peak = 0; peak < m_numPeaks; ++peak)
+    {
+        if (m_peakTracks[peak] >= 0 || m_numTracks == PartialTracks::maxTracks)
+            continue;
+
+        const int track = m_numTracks++;
+        m_trackIds[track] = m_nextId++;
+        m_trackFrequencies[track] = m_peakFrequencies[peak];
+        m_trackLevels[track] = m_peakLevels[peak];
+        m_trackAges[track] = 1;
+        m_missedFrames[track] = 0;
+        m_peakTracks[peak] = track;
+    }
+}
+
+void PartialTracker::removeTrack(int track) noexcept
+{
+    const int lastTrack = --m_numTracks;
+    if (track == lastTrack)
+        return;
+
+    m_trackIds[track] = m_trackIds[lastTrack];
+    m_trackFrequencies[track] = m_trackFrequencies[lastTrack];
+    m_trackLevels[track] = m_trackLevels[lastTrack];
+    m_trackAges[track] = m_trackAges[lastTrack];
+    m_missedFrames[track] = m_missedFrames[lastTrack];
+
+    // Keep the peaks pointing to the moved track
+    for (int peak = 0; peak < m_numPeaks; ++peak)
+    {
+        if (m_peakTracks[peak] == lastTrack)
+            m_peakTracks[peak] = track;
+    }
+}
\ No newline at end of file
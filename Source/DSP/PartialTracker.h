@@ -0,0 +1,102 @@
+//--------------------------------------------------------------------------------------------
+// Name: PartialTracker.h
+// Author: Jérémi Panneton
+// Creation date: October 16th, 2026
+//--------------------------------------------------------------------------------------------
+
+#pragma once
+
+#include "JuceHeader.h"
+#include <array>
+
+//--------------------------------------------------------------------------------------------
+/// Partials tracked in a spectral frame, stored as a struct of arrays (one entry for each track).
+/// The size is fixed, so copying the tracks of a frame never allocates.
+//--------------------------------------------------------------------------------------------
+struct PartialTracks
+{
+    enum
+    {
+        maxTracks = 32
+    };
+
+    int numTracks = 0;								/// Number of valid tracks, sorted by decreasing level.
+    std::array<uint32, maxTracks> ids {};			/// Identifier of each track, kept from frame to frame.
+    std::array<float, maxTracks> frequencies {};	/// Interpolated frequency of each track.
+    std::array<float, maxTracks> levels {};			/// Interpolated level in dB of each track.
+    std::array<int, maxTracks> ages {};				/// Number of frames since each track started.
+    std::array<int, maxTracks> rows {};				/// Index of the closest frequency of the axis the frame was analyzed with (-1 if out of its range).
+};
+
+//--------------------------------------------------------------------------------------------
+/// Detects the spectral peaks of consecutive frames and links them into partial tracks.
+/// Only the loudest maxPeaks peaks of a frame are kept, and the tracks live in fixed-size pools,
+/// so the cost of a frame is bounded and nothing is allocated after construction.
+//--------------------------------------------------------------------------------------------
+class PartialTracker
+{
+public:
+    enum
+    {
+        maxPeaks = PartialTracks::maxTracks,
+        maxMissedFrames = 3 // Number of frames a track survives without any peak before being released
+    };
+
+    //----------------------------------------------------------------------------------------
+    /// Constructor.
+    //----------------------------------------------------------------------------------------
+    PartialTracker();
+
+    //----------------------------------------------------------------------------------------
+    /// Releases every track.
+    //----------------------------------------------------------------------------------------
+    void reset() noexcept;
+
+    //----------------------------------------------------------------------------------------
+    /// Detects the peaks of a frame and links them to the current tracks.
+    /// @param[in] dbLevels					Levels in dB of the frame.
+    /// @param[in] frequencies				Frequency of each level (increasing).
+    /// @param[in] numValues				Number of levels in the frame.
+    /// @param[out] tracks					Tracks containing a peak of this frame.
+    //----------------------------------------------------------------------------------------
+    void process(const float* dbLevels, const float* frequencies, int numValues, PartialTracks& tracks) noexcept;
+
+private:
+    //----------------------------------------------------------------------------------------
+    /// Finds the loudest local maxima of a frame and refines them with a parabolic interpolation.
+    /// The peaks are stored by decreasing level.
+    /// @param[in] dbLevels					Levels in dB of the frame.
+    /// @param[in] frequencies				Frequency of each level (increasing).
+    /// @param[in] numValues				Number of levels in the frame.
+    //----------------------------------------------------------------------------------------
+    void detectPeaks(const float* dbLevels, const float* frequencies, int numValues) noexcept;
+
+    //----------------------------------------------------------------------------------------
+    /// Continues the tracks with the peaks of the frame. The loudest peaks pick their track first.
+    /// Unmatched tracks get released after maxMissedFrames, and unmatched peaks start new tracks.
+    //----------------------------------------------------------------------------------------
+    void linkPeaks() noexcept;
+
+    //----------------------------------------------------------------------------------------
+    /// Removes a track from the pool by moving the last one in its slot.
+    /// @param[in] track					Index of the track to remove.
+    //----------------------------------------------------------------------------------------
+    void removeTrack(int track) noexcept;
+
+    // Peaks of the current frame
+    int m_numPeaks = 0;											/// Number of detected peaks.
+    std::array<float, maxPeaks> m_peakFrequencies;				/// Interpolated frequency of each peak.
+    std::array<float, maxPeaks> m_peakLevels;					/// Interpolated level in dB of each peak.
+    std::array<int, maxPeaks> m_peakTracks;						/// Track continued or started by each peak (-1 if none).
+
+    // Track pool (the active tracks are packed at the beginning)
+    int m_numTracks = 0;										/// Number of active tracks.
+    std::array<uint32, PartialTracks::maxTracks> m_trackIds;	/// Identifier of each track.
+    std::array<float, PartialTracks::maxTracks> m_trackFrequencies; /// Latest frequency of each track.
+    std::array<float, PartialTracks::maxTracks> m_trackLevels;	/// Latest level in dB of each track.
+    std::array<int, PartialTracks::maxTracks> m_trackAges;		/// Number of frames since each track started.
+    std::array<int, PartialTracks::maxTracks> m_missedFrames;	/// Number of consecutive frames without any peak for each track.
+    uint32 m_nextId = 0;										/// Identifier of the next track.
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PartialTracker)
+};
\ No newline at end of file
@@ -0,0 +1,160 @@
+//--------------------------------------------------------------------------------------------
+// Name: RadixFFT.cpp
+// Author: Jérémi Panneton
+// Creation date: October 16th, 2026
+//--------------------------------------------------------------------------------------------
+
+#include "RadixFFT.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+ #include <emmintrin.h>
+ #define RADIX_FFT_USE_SSE 1
+#endif
+
+namespace
+{
+    using Complex = RadixFFT::Complex;
+
+    // Plain arithmetic, so that the compiler doesn't have to handle the infinite cases of std::complex
+    inline Complex add(Complex a, Complex b) noexcept { return { a.real() + b.real(), a.imag() + b.imag() }; }
+    inline Complex subtract(Complex a, Complex b) noexcept { return { a.real() - b.real(), a.imag() - b.imag() }; }
+    inline Complex multiplyByI(Complex a) noexcept { return { -a.imag(), a.real() }; }
+    inline Complex multiply(Complex a, Complex b) noexcept
+    {
+        return { a.real() * b.real() - a.imag() * b.imag(), a.real() * b.imag() + a.imag() * b.real() };
+    }
+
+#if RADIX_FFT_USE_SSE
+    // Two complex values per register: { re0, im0, re1, im1 }
+    inline __m128 swapParts(__m128 a) noexcept { return _mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1)); }
+    inline __m128 multiplyByI(__m128 a) noexcept { return _mm_mul_ps(swapParts(a), _mm_set_ps(1.0f, -1.0f, 1.0f, -1.0f)); }
+    inline __m128 multiply(__m128 a, Complex w) noexcept
+    {
+        // (ar + i * ai) * (wr + i * wi) = ar * wr - ai * wi + i * (ai * wr + ar * wi)
+        const __m128 imaginary = _mm_set_ps(w.imag(), -w.imag(), w.imag(), -w.imag());
+        return _mm_add_ps(_mm_mul_ps(a, _mm_set1_ps(w.real())), _mm_mul_ps(swapParts(a), imaginary));
+    }
+#endif
+}
+
+RadixFFT::RadixFFT(int order)
+    : m_size(1 << order)
+    , m_twiddles(static_cast<size_t>(m_size))
+    , m_workBuffer(static_cast<size_t>(m_size))
+{
+    for (int k = 0; k < m_size; ++k)
+    {
+        // Computed in double precision, since the twiddles of the large sizes are reused by every stage
+        const double angle = -2.0 * MathConstants<double>::pi * k / m_size;
+        m_twiddles[k] = { static_cast<float>(std::cos(angle)), static_cast<float>(std::sin(angle)) };
+    }
+
+    m_numStages = order / 2 + (order % 2);
+}
+
+int RadixFFT::getSize() const noexcept
+{
+    return m_size;
+}
+
+void RadixFFT::perform(const Complex* input, Complex* output) noexcept
+{
+    jassert(input != output);
+
+    if (m_size == 1)
+    {
+        output[0] = input[0];
+        return;
+    }
+
+    // The stages alternate between the two buffers, so that the last one writes into the output
+    const Complex* stageInput = input;
+    int length = m_size;
+    int stride = 1;
+
+    for (int stage = 0; stage < m_numStages; ++stage)
+    {
+        Complex* stageOutput = (m_numStages - 1 - stage) % 2 == 0 ? output : m_workBuffer.getData();
+
+        if (length >= 4)
+        {
+            performRadix4Stage(stageInput, stageOutput, length, stride);
+            length /= 4;
+            stride *= 4;
+        }
+        else
+        {
+            performRadix2Stage(stageInput, stageOutput, stride);
+            length = 1;
+        }
+
+        stageInput = stageOutput;
+    }
+}
+
+void RadixFFT::performRadix4Stage(const Complex* input, Complex* output, int length, int stride) const noexcept
+{
+    const int quarter = length / 4;
+
+    for (int p = 0; p < quarter; ++p)
+    {
+        // Twiddles of the sub-transform length (e^(-2i * pi * p / length) = e^(-2i * pi * p * stride / size))
+        const Complex w1 = m_twiddles[p * stride];
+        const Complex w2 = m_twiddles[2 * p * stride];
+        const Complex w3 = m_twiddles[3 * p * stride];
+
+        const Complex* a = input + stride * p;
+        const Complex* b = input + stride * (p + quarter);
+        const Complex* c = input + stride * (p + 2 * quarter);
+        const Complex* d = input + stride * (p + 3 * quarter);
+        Complex* y0 = output + stride * (4 * p);
+        Complex* y1 = output + stride * (4 * p + 1);
+        Complex* y2 = output + stride * (4 * p + 2);
+        Complex* y3 = output + stride * (4 * p + 3);
+
+        int q = 0;
+#if RADIX_FFT_USE_SSE
+        for (; q + 2 <= stride; q += 2)
+        {
+            const __m128 va = _mm_loadu_ps(reinterpret_cast<const float*>(a + q));
+            const __m128 vb = _mm_loadu_ps(reinterpret_cast<const float*>(b + q));
+            const __m128 vc = _mm_loadu_ps(reinterpret_cast<const float*>(c + q));
+            const __m128 vd = _mm_loadu_ps(reinterpret_cast<const float*>(d + q));
+
+            const __m128 aPlusC = _mm_add_ps(va, vc);
+            const __m128 aMinusC = _mm_sub_ps(va, vc);
+            const __m128 bPlusD = _mm_add_ps(vb, vd);
+            const __m128 iBMinusD = multiplyByI(_mm_sub_ps(vb, vd));
+
+            _mm_storeu_ps(reinterpret_cast<float*>(y0 + q), _mm_add_ps(aPlusC, bPlusD));
+            _mm_storeu_ps(reinterpret_cast<float*>(y1 + q), multiply(_mm_sub_ps(aMinusC, iBMinusD), w1));
+            _mm_storeu_ps(reinterpret_cast<float*>(y2 + q), multiply(_mm_sub_ps(aPlusC, bPlusD), w2));
+            _mm_storeu_ps(reinterpret_cast<float*>(y3 + q), multiply(_mm_add_ps(aMinusC, iBMinusD), w3));
+        }
+#endif
+
+        for (; q < stride; ++q)
+        {
+            const Complex aPlusC = add(a[q], c[q]);
+            const Complex aMinusC = subtract(a[q], c[q]);
+            const Complex bPlusD = add(b[q], d[q]);
+            const Complex iBMinusD = multiplyByI(subtract(b[q], d[q]));
+
+            y0[q] = add(aPlusC, bPlusD);
+            y1[q] = multiply(subtract(aMinusC, iBMinusD), w1);
+            y2[q] = multiply(subtract(aPlusC, bPlusD), w2);
+            y3[q] = multiply(add(aMinusC, iBMinusD), w3);
+        }
+    }
+}
+
+void RadixFFT::performRadix2Stage(const Complex* input, Complex* output, int stride) const noexcept
+{
+    for (int q = 0; q < stride; ++q)
+    {
+        const Complex a = input[q];
+        const Complex b = input[q + stride];
+        output[q] = add(a, b);
+        output[q + stride] = subtract(a, b);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,63 @@
+//--------------------------------------------------------------------------------------------
+// Name: RadixFFT.h
+// Author: Jérémi Panneton
+// Creation date: October 16th, 2026
+//--------------------------------------------------------------------------------------------
+
+#pragma once
+
+#include "JuceHeader.h"
+
+//--------------------------------------------------------------------------------------------
+/// Forward complex FFT of a power of 2 size (Stockham autosort, radix 4 with a final radix 2 stage if needed).
+/// The stages ping-pong between the output and a preallocated work buffer, so there is no bit reversal pass,
+/// and the butterflies of the later stages read and write contiguous blocks, two complex values at a time with SSE.
+//--------------------------------------------------------------------------------------------
+class RadixFFT
+{
+public:
+    using Complex = dsp::Complex<float>;
+
+    //----------------------------------------------------------------------------------------
+    /// Constructor. The twiddles and the work buffer are allocated here.
+    /// @param[in] order					FFT order (size = 2 ^ order).
+    //----------------------------------------------------------------------------------------
+    RadixFFT(int order);
+
+    //----------------------------------------------------------------------------------------
+    /// Performs the forward transform (not normalized, like dsp::FFT).
+    /// @param[in] input					Input values (size values).
+    /// @param[out] output					Transformed values (size values). Should not be the same buffer as input.
+    //----------------------------------------------------------------------------------------
+    void perform(const Complex* input, Complex* output) noexcept;
+
+    //----------------------------------------------------------------------------------------
+    /// Returns the size of the transform.
+    //----------------------------------------------------------------------------------------
+    int getSize() const noexcept;
+
+private:
+    //----------------------------------------------------------------------------------------
+    /// Performs a radix 4 stage.
+    /// @param[in] input					Values of the previous stage.
+    /// @param[out] output					Values of this stage.
+    /// @param[in] length					Length of the sub-transforms at this stage.
+    /// @param[in] stride					Number of interleaved sub-transforms (size / length).
+    //----------------------------------------------------------------------------------------
+    void performRadix4Stage(const Complex* input, Complex* output, int length, int stride) const noexcept;
+
+    //----------------------------------------------------------------------------------------
+    /// Performs the final radix 2 stage (sub-transforms of length 2, without twiddles).
+    /// @param[in] input					Values of the previous stage.
+    /// @param[out] output					Values of this stage.
+    /// @param[in] stride					Number of interleaved sub-transforms (size / 2).
+    //----------------------------------------------------------------------------------------
+    void performRadix2Stage(const Complex* input, Complex* output, int stride) const noexcept;
+
+    const int m_size;						/// Size of the transform.
+    int m_numStages = 0;					/// Number of stages (radix 4 stages, plus one radix 2 stage for odd orders).
+    HeapBlock<Complex> m_twiddles;			/// e^(-2i * pi * k / size) for each k in [0, size).
+    HeapBlock<Complex> m_workBuffer;		/// Intermediate values of every other stage.
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(RadixFFT)
+};
\ No newline at end of file
@@ -0,0 +1,99 @@
+//--------------------------------------------------------------------------------------------
+// Name: RangeMax.h
+// Author: Jérémi Panneton
+// Creation date: October 16th, 2026
+//--------------------------------------------------------------------------------------------
+
+#pragma once
+
+#include "JuceHeader.h"
+
+#if defined(__AVX__)
+ #include <immintrin.h>
+ #define RANGE_MAX_USE_AVX 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+ #include <emmintrin.h>
+ #define RANGE_MAX_USE_SSE 1
+#endif
+
+//--------------------------------------------------------------------------------------------
+/// Returns the index of the largest value of a range. On ties, the first occurrence is returned.
+/// The maximum is found with SIMD registers (AVX or SSE when available, scalar otherwise),
+/// then a second vectorized pass locates its first occurrence.
+/// @param[in] data							Values of the range.
+/// @param[in] size							Number of values in the range (at least one).
+/// @return									Index of the largest value, relative to data.
+//--------------------------------------------------------------------------------------------
+inline int findMaxIndex(const float* data, int size) noexcept
+{
+    jassert(size > 0);
+
+    float maxValue = data[0];
+    int i = 0;
+
+#if RANGE_MAX_USE_AVX
+    if (size >= 16)
+    {
+        __m256 maxVector = _mm256_loadu_ps(data);
+        for (i = 8; i + 8 <= size; i += 8)
+        {
+            maxVector = _mm256_max_ps(maxVector, _mm256_loadu_ps(data + i));
+        }
+
+        __m128 maxHalf = _mm_max_ps(_mm256_castps256_ps128(maxVector), _mm256_extractf128_ps(maxVector, 1));
+        maxHalf = _mm_max_ps(maxHalf, _mm_movehl_ps(maxHalf, maxHalf));
+        maxHalf = _mm_max_ss(maxHalf, _mm_shuffle_ps(maxHalf, maxHalf, 1));
+        maxValue = _mm_cvtss_f32(maxHalf);
+    }
+#elif RANGE_MAX_USE_SSE
+    if (size >= 8)
+    {
+        __m128 maxVector = _mm_loadu_ps(data);
+        for (i = 4; i + 4 <= size; i += 4)
+        {
+            maxVector = _mm_max_ps(maxVector, _mm_loadu_ps(data + i));
+        }
+
+        maxVector = _mm_max_ps(maxVector, _mm_movehl_ps(maxVector, maxVector));
+        maxVector = _mm_max_ss(maxVector, _mm_shuffle_ps(maxVector, maxVector, 1));
+        maxValue = _mm_cvtss_f32(maxVector);
+    }
+#endif
+
+    // Remaining values (or the whole range when it is too short to vectorize)
+    for (; i < size; ++i)
+    {
+        if (data[i] > maxValue)
+            maxValue = data[i];
+    }
+
+    // Locate the first occurrence of the maximum
+    i = 0;
+
+#if RANGE_MAX_USE_AVX
+    const __m256 target = _mm256_set1_ps(maxValue);
+    for (; i + 8 <= size; i += 8)
+    {
+        const int mask = _mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(data + i), target, _CMP_EQ_OQ));
+        if (mask != 0)
+            return i + findHighestSetBit(static_cast<uint32>(mask & -mask));
+    }
+#elif RANGE_MAX_USE_SSE
+    const __m128 target = _mm_set1_ps(maxValue);
+    for (; i + 4 <= size; i += 4)
+    {
+        const int mask = _mm_movemask_ps(_mm_cmpeq_ps(_mm_loadu_ps(data + i), target));
+        if (mask != 0)
+            return i + findHighestSetBit(static_cast<uint32>(mask & -mask));
+    }
+#endif
+
+    for (; i < size; ++i)
+    {
+        if (data[i] == maxValue)
+            return i;
+    }
+
+    jassertfalse; // The maximum is always part of the range
+    return 0;
+}
\ No newline at end of file
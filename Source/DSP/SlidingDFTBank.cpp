@@ -0,0 +1,191 @@
+//--------------------------------------------------------------------------------------------
+// Name: SlidingDFTBank.cpp
+// Author: Jérémi Panneton
+// Creation date: October 16th, 2026
+//--------------------------------------------------------------------------------------------
+
+#include "SlidingDFTBank.h"
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+ #include <emmintrin.h>
+ #define SLIDING_DFT_USE_SSE 1
+#endif
+
+namespace
+{
+    // Pole radius. Its float rounding can't reach 1, and the oldest sample of a 32768 samples DFT still weighs 97%.
+    constexpr double damping = 1.0 - 1.0e-6;
+
+    std::complex<double> roundToFloat(std::complex<double> value) noexcept
+    {
+        return { static_cast<float>(value.real()), static_cast<float>(value.imag()) };
+    }
+}
+
+SlidingDFTBank::SlidingDFTBank(int maxLength)
+    : m_delayLine(static_cast<size_t>(maxLength))
+    , m_maxLength(maxLength)
+{
+    std::memset(m_resonators, 0, sizeof(m_resonators));
+    setFrequencies(nullptr, 0, maxLength, 44100.0);
+}
+
+void SlidingDFTBank::setFrequencies(const float* frequencies, int numFrequencies, int length, double sampleRate) noexcept
+{
+    jassert(numFrequencies <= maxFrequencies);
+    jassert(length > 0 && length <= m_maxLength);
+
+    m_length = jlimit(1, m_maxLength, length);
+    m_numFrequencies = 0;
+
+    for (int i = 0; i < jmin(numFrequencies, static_cast<int>(maxFrequencies)); ++i)
+    {
+        if (frequencies[i] > 0.0f && frequencies[i] < sampleRate / 2)
+            m_frequencies[m_numFrequencies++] = frequencies[i];
+    }
+
+    // The unused lanes of the last register get null coefficients, so they stay at 0
+    m_numPadded = (m_numFrequencies + 3) & ~3;
+    std::memset(m_resonators, 0, sizeof(m_resonators));
+
+    // Hann window over the age j of the samples (0 for the newest): 0.5 - 0.25 * e^(i * delta * j) - 0.25 * e^(-i * delta * j),
+    // with delta = 2 * pi / length. Since S(w)[n] = sum of x[n - j] * e^(i * w * (j + 1)), the windowed DFT is
+    // 0.5 * S(w) - 0.25 * e^(-i * delta) * S(w + delta) - 0.25 * e^(i * delta) * S(w - delta).
+    // A sine of amplitude A gives A / 2 * length / 2, hence the final scaling by 4 / length.
+    const double delta = MathConstants<double>::twoPi / m_length;
+    const double scaling = 4.0 / m_length;
+    const double offsets[numNeighbors] = { 0.0, delta, -delta };
+    const std::complex<double> weights[numNeighbors] = { 0.5 * scaling, -0.25 * scaling * std::polar(1.0, -delta), -0.25 * scaling * std::polar(1.0, delta) };
+
+    for (int neighbor = 0; neighbor < numNeighbors; ++neighbor)
+    {
+        auto& resonators = m_resonators[neighbor];
+
+        for (int i = 0; i < m_numFrequencies; ++i)
+        {
+            const double w = MathConstants<double>::twoPi * m_frequencies[i] / sampleRate + offsets[neighbor];
+            const auto pole = roundToFloat(std::polar(damping, w));
+            const auto input = roundToFloat(std::polar(1.0, w));
+            // Computed from the rounded coefficients, so that a sample leaves the DFT with exactly the weight it has reached
+            const auto delayed = std::pow(pole, m_length) * input;
+
+            resonators.poleReal[i] = static_cast<float>(pole.real());
+            resonators.poleImag[i] = static_cast<float>(pole.imag());
+            resonators.inputReal[i] = static_cast<float>(input.real());
+            resonators.inputImag[i] = static_cast<float>(input.imag());
+            resonators.delayedReal[i] = static_cast<float>(delayed.real());
+            resonators.delayedImag[i] = static_cast<float>(delayed.imag());
+            resonators.weightReal[i] = static_cast<float>(weights[neighbor].real());
+            resonators.weightImag[i] = static_cast<float>(weights[neighbor].imag());
+        }
+    }
+
+    reset();
+}
+
+void SlidingDFTBank::reset() noexcept
+{
+    for (auto& resonators : m_resonators)
+    {
+        std::memset(resonators.stateReal, 0, sizeof(resonators.stateReal));
+        std::memset(resonators.stateImag, 0, sizeof(resonators.stateImag));
+    }
+
+    std::memset(m_delayLine.getData(), 0, sizeof(float) * static_cast<size_t>(m_length));
+    m_delayPosition = 0;
+}
+
+int SlidingDFTBank::getNumFrequencies() const noexcept
+{
+    return m_numFrequencies;
+}
+
+float SlidingDFTBank::getFrequency(int index) const noexcept
+{
+    jassert(index >= 0 && index < m_numFrequencies);
+    return m_frequencies[index];
+}
+
+void SlidingDFTBank::process(const float* input, int numSamples, float* peakMagnitudes) noexcept
+{
+    std::memset(m_peakPowers, 0, sizeof(m_peakPowers));
+
+    for (int n = 0; n < numSamples; ++n)
+    {
+        // The delay line holds the last length samples, the oldest one being replaced by the new one
+        const float sample = input[n];
+        const float delayedSample = m_delayLine[m_delayPosition];
+        m_delayLine[m_delayPosition] = sample;
+        m_delayPosition = m_delayPosition + 1 < m_length ? m_delayPosition + 1 : 0;
+
+        processSample(sample, delayedSample);
+    }
+
+    for (int i = 0; i < m_numFrequencies; ++i)
+    {
+        peakMagnitudes[i] = std::sqrt(m_peakPowers[i]);
+    }
+}
+
+void SlidingDFTBank::processSample(float sample, float delayedSample) noexcept
+{
+    int i = 0;
+
+#if SLIDING_DFT_USE_SSE
+    const __m128 x = _mm_set1_ps(sample);
+    const __m128 delayedX = _mm_set1_ps(delayedSample);
+
+    for (; i < m_numPadded; i += 4)
+    {
+        __m128 windowedReal = _mm_setzero_ps();
+        __m128 windowedImag = _mm_setzero_ps();
+
+        for (auto& r : m_resonators)
+        {
+            const __m128 stateReal = _mm_loadu_ps(r.stateReal + i);
+            const __m128 stateImag = _mm_loadu_ps(r.stateImag + i);
+            const __m128 poleReal = _mm_loadu_ps(r.poleReal + i);
+            const __m128 poleImag = _mm_loadu_ps(r.poleImag + i);
+
+            // S = pole * S + input * x - delayed * x[n - length]
+            __m128 newReal = _mm_sub_ps(_mm_mul_ps(poleReal, stateReal), _mm_mul_ps(poleImag, stateImag));
+            __m128 newImag = _mm_add_ps(_mm_mul_ps(poleReal, stateImag), _mm_mul_ps(poleImag, stateReal));
+            newReal = _mm_add_ps(newReal, _mm_sub_ps(_mm_mul_ps(_mm_loadu_ps(r.inputReal + i), x), _mm_mul_ps(_mm_loadu_ps(r.delayedReal + i), delayedX)));
+            newImag = _mm_add_ps(newImag, _mm_sub_ps(_mm_mul_ps(_mm_loadu_ps(r.inputImag + i), x), _mm_mul_ps(_mm_loadu_ps(r.delayedImag + i), delayedX)));
+            _mm_storeu_ps(r.stateReal + i, newReal);
+            _mm_storeu_ps(r.stateImag + i, newImag);
+
+            // Accumulate the Hann-windowed value
+            const __m128 weightReal = _mm_loadu_ps(r.weightReal + i);
+            const __m128 weightImag = _mm_loadu_ps(r.weightImag + i);
+            windowedReal = _mm_add_ps(windowedReal, _mm_sub_ps(_mm_mul_ps(weightReal, newReal), _mm_mul_ps(weightImag, newImag)));
+            windowedImag = _mm_add_ps(windowedImag, _mm_add_ps(_mm_mul_ps(weightReal, newImag), _mm_mul_ps(weightImag, newReal)));
+        }
+
+        const __m128 power = _mm_add_ps(_mm_mul_ps(windowedReal, windowedReal), _mm_mul_ps(windowedImag, windowedImag));
+        _mm_storeu_ps(m_peakPowers + i, _mm_max_ps(_mm_loadu_ps(m_peakPowers + i), power));
+    }
+#endif
+
+    for (; i < m_numFrequencies; ++i)
+    {
+        float windowedReal = 0.0f;
+        float windowedImag = 0.0f;
+
+        for (auto& r : m_resonators)
+        {
+            const float stateReal = r.stateReal[i];
+            const float stateImag = r.stateImag[i];
+            const float newReal = r.poleReal[i] * stateReal - r.poleImag[i] * stateImag + r.inputReal[i] * sample - r.delayedReal[i] * delayedSample;
+            const float newImag = r.poleReal[i] * stateImag + r.poleImag[i] * stateReal + r.inputImag[i] * sample - r.delayedImag[i] * delayedSample;
+            r.stateReal[i] = newReal;
+            r.stateImag[i] = newImag;
+
+            windowedReal += r.weightReal[i] * newReal - r.weightImag[i] * newImag;
+            windowedImag += r.weightReal[i] * newImag + r.weightImag[i] * newReal;
+        }
+
+        m_peakPowers[i] = jmax(m_peakPowers[i], windowedReal * windowedReal + windowedImag * windowedImag);
+    }
+}
\ No newline at end of file
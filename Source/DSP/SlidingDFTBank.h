@@ -0,0 +1,113 @@
+//--------------------------------------------------------------------------------------------
+// Name: SlidingDFTBank.h
+// Author: Jérémi Panneton
+// Creation date: October 16th, 2026
+//--------------------------------------------------------------------------------------------
+
+#pragma once
+
+#include "JuceHeader.h"
+
+//--------------------------------------------------------------------------------------------
+/// Bank of sliding DFT resonators, each one tracking a single frequency sample by sample.
+/// Every frequency gets three resonators (itself and its two neighbors one bin apart), which are combined
+/// into a Hann-windowed DFT over the last length samples, so the leakage matches the Hann window of the FFT mode.
+/// The resonators are stored as a struct of arrays and updated four at a time with SSE.
+/// A slight damping keeps the recursion stable, since the float rounding errors would otherwise accumulate forever.
+//--------------------------------------------------------------------------------------------
+class SlidingDFTBank
+{
+public:
+    enum
+    {
+        maxFrequencies = 16
+    };
+
+    //----------------------------------------------------------------------------------------
+    /// Constructor. The delay line and the resonators are allocated here.
+    /// @param[in] maxLength				Maximum length of the DFT (in samples).
+    //----------------------------------------------------------------------------------------
+    SlidingDFTBank(int maxLength);
+
+    //----------------------------------------------------------------------------------------
+    /// Sets the tracked frequencies and clears the resonators. Doesn't allocate.
+    /// @param[in] frequencies				Tracked frequencies (in Hz). The ones above the Nyquist frequency are ignored.
+    /// @param[in] numFrequencies			Number of tracked frequencies (at most maxFrequencies).
+    /// @param[in] length					Length of the DFT (in samples), which sets the resolution (sampleRate / length).
+    /// @param[in] sampleRate				Sample rate of the processed signal.
+    //----------------------------------------------------------------------------------------
+    void setFrequencies(const float* frequencies, int numFrequencies, int length, double sampleRate) noexcept;
+
+    //----------------------------------------------------------------------------------------
+    /// Clears the resonators and the delay line.
+    //----------------------------------------------------------------------------------------
+    void reset() noexcept;
+
+    //----------------------------------------------------------------------------------------
+    /// Feeds a block of samples to every resonator.
+    /// @param[in] input					Samples to process.
+    /// @param[in] numSamples				Number of samples to process.
+    /// @param[out] peakMagnitudes			Highest magnitude reached by each tracked frequency during the block (getNumFrequencies() values).
+    ///										A sine of amplitude A on a tracked frequency gives a magnitude of A.
+    //----------------------------------------------------------------------------------------
+    void process(const float* input, int numSamples, float* peakMagnitudes) noexcept;
+
+    //----------------------------------------------------------------------------------------
+    /// Returns the number of tracked frequencies.
+    //----------------------------------------------------------------------------------------
+    int getNumFrequencies() const noexcept;
+
+    //----------------------------------------------------------------------------------------
+    /// Returns a tracked frequency.
+    /// @param[in] index					Index of the frequency.
+    //----------------------------------------------------------------------------------------
+    float getFrequency(int index) const noexcept;
+
+private:
+    static_assert(maxFrequencies % 4 == 0, "The resonators are processed four at a time");
+
+    //----------------------------------------------------------------------------------------
+    /// Resonators of one neighbor (center, upper or lower) of every tracked frequency, as a struct of arrays.
+    /// The recursion is S[n] = pole * S[n - 1] + input * x[n] - delayed * x[n - length].
+    //----------------------------------------------------------------------------------------
+    struct Resonators
+    {
+        float stateReal[maxFrequencies];	/// Current DFT value (real part).
+        float stateImag[maxFrequencies];	/// Current DFT value (imaginary part).
+        float poleReal[maxFrequencies];		/// damping * e^(i * w) (real part).
+        float poleImag[maxFrequencies];		/// damping * e^(i * w) (imaginary part).
+        float inputReal[maxFrequencies];	/// e^(i * w) (real part).
+        float inputImag[maxFrequencies];	/// e^(i * w) (imaginary part).
+        float delayedReal[maxFrequencies];	/// damping ^ length * e^(i * w * (length + 1)) (real part).
+        float delayedImag[maxFrequencies];	/// damping ^ length * e^(i * w * (length + 1)) (imaginary part).
+        float weightReal[maxFrequencies];	/// Weight of the resonator in the Hann window (real part).
+        float weightImag[maxFrequencies];	/// Weight of the resonator in the Hann window (imaginary part).
+    };
+
+    enum
+    {
+        center = 0,
+        upper = 1,
+        lower = 2,
+        numNeighbors = 3
+    };
+
+    //----------------------------------------------------------------------------------------
+    /// Updates every resonator with one sample.
+    /// @param[in] sample					New sample.
+    /// @param[in] delayedSample			Sample leaving the DFT (length samples ago).
+    //----------------------------------------------------------------------------------------
+    void processSample(float sample, float delayedSample) noexcept;
+
+    Resonators m_resonators[numNeighbors];	/// Resonators of each neighbor.
+    float m_frequencies[maxFrequencies];	/// Tracked frequencies.
+    float m_peakPowers[maxFrequencies];		/// Highest squared magnitude of each frequency during the current block.
+    int m_numFrequencies = 0;				/// Number of tracked frequencies.
+    int m_numPadded = 0;					/// Number of tracked frequencies rounded up to a multiple of 4.
+    HeapBlock<float> m_delayLine;			/// Last length samples.
+    const int m_maxLength;					/// Maximum length of the DFT.
+    int m_length = 1;						/// Length of the DFT.
+    int m_delayPosition = 0;				/// Position of the oldest sample in the delay line.
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SlidingDFTBank)
+};
\ No newline at end of file
@@ -0,0 +1,97 @@
+//--------------------------------------------------------------------------------------------
+// Name: SparseRowMatrix.cpp
+// Author: Jérémi Panneton
+// Creation date: October 16th, 2026
+//--------------------------------------------------------------------------------------------
+
+#include "SparseRowMatrix.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+ #include <emmintrin.h>
+ #define SPARSE_ROW_MATRIX_USE_SSE 1
+#endif
+
+SparseRowMatrix::SparseRowMatrix(int maxRows, int maxWeights)
+{
+    m_rowOffsets.reserve(static_cast<size_t>(maxRows + 1));
+    m_firstColumns.reserve(static_cast<size_t>(maxRows));
+    m_weights.reserve(static_cast<size_t>(maxWeights));
+    m_rowOffsets.push_back(0);
+}
+
+void SparseRowMatrix::clear() noexcept
+{
+    m_rowOffsets.clear();
+    m_firstColumns.clear();
+    m_weights.clear();
+    m_rowOffsets.push_back(0);
+}
+
+void SparseRowMatrix::beginRow(int firstColumn)
+{
+    jassert(m_firstColumns.size() + 1 == m_rowOffsets.size());
+    m_firstColumns.push_back(firstColumn);
+}
+
+void SparseRowMatrix::addWeight(float weight)
+{
+    m_weights.push_back(weight);
+}
+
+void SparseRowMatrix::endRow(int numColumns)
+{
+    const int rowStart = m_rowOffsets.back();
+    const int rowSize = static_cast<int>(m_weights.size()) - rowStart;
+    const int paddedSize = (rowSize + rowAlignment - 1) / rowAlignment * rowAlignment;
+    jassert(paddedSize <= numColumns);
+
+    // Move the row back if its padding would read past the input
+    const int shift = jlimit(0, m_firstColumns.back(), m_firstColumns.back() + paddedSize - numColumns);
+    m_firstColumns.back() -= shift;
+    m_weights.insert(m_weights.begin() + rowStart, static_cast<size_t>(shift), 0.0f);
+    m_weights.resize(static_cast<size_t>(rowStart + paddedSize), 0.0f);
+
+    m_rowOffsets.push_back(static_cast<int>(m_weights.size()));
+}
+
+void SparseRowMatrix::apply(const float* inputData, float* outputData) const noexcept
+{
+    const int numRows = getNumRows();
+    const float* weights = m_weights.data();
+
+    for (int row = 0; row < numRows; ++row)
+    {
+        // The columns of a row are contiguous, so this is a plain dot product
+        const int rowStart = m_rowOffsets[row];
+        const int rowSize = m_rowOffsets[row + 1] - rowStart;
+        const float* rowWeights = weights + rowStart;
+        const float* rowInput = inputData + m_firstColumns[row];
+
+#if SPARSE_ROW_MATRIX_USE_SSE
+        // The rows are padded, so every column fits in a register
+        __m128 sum = _mm_setzero_ps();
+        for (int i = 0; i < rowSize; i += rowAlignment)
+        {
+            sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(rowWeights + i), _mm_loadu_ps(rowInput + i)));
+        }
+
+        // Horizontal sum of the four lanes
+        sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+        sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, _MM_SHUFFLE(1, 1, 1, 1)));
+        outputData[row] = _mm_cvtss_f32(sum);
+#else
+        float sum = 0.0f;
+        for (int i = 0; i < rowSize; ++i)
+        {
+            sum += rowWeights[i] * rowInput[i];
+        }
+
+        outputData[row] = sum;
+#endif
+    }
+}
+
+int SparseRowMatrix::getNumRows() const noexcept
+{
+    return static_cast<int>(m_firstColumns.size());
+}
\ No newline at end of file
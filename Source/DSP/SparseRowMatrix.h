@@ -0,0 +1,73 @@
+//--------------------------------------------------------------------------------------------
+// Name: SparseRowMatrix.h
+// Author: Jérémi Panneton
+// Creation date: October 16th, 2026
+//--------------------------------------------------------------------------------------------
+
+#pragma once
+
+#include "JuceHeader.h"
+#include <vector>
+
+//--------------------------------------------------------------------------------------------
+/// Sparse matrix whose rows only hold contiguous columns (the taps of a kernel or a filter).
+/// Rows are stored in a CSR-like layout where only the first column of each row needs to be stored.
+/// Every row is padded with null weights to a multiple of rowAlignment columns,
+/// so the matrix-vector product runs on whole SSE registers.
+//--------------------------------------------------------------------------------------------
+class SparseRowMatrix
+{
+public:
+    enum
+    {
+        rowAlignment = 4
+    };
+
+    //----------------------------------------------------------------------------------------
+    /// Constructor. Preallocates the matrix, so that rebuilding it within these sizes never allocates.
+    /// @param[in] maxRows					Maximum number of rows.
+    /// @param[in] maxWeights				Maximum number of weights, padding included.
+    //----------------------------------------------------------------------------------------
+    SparseRowMatrix(int maxRows = 0, int maxWeights = 0);
+
+    //----------------------------------------------------------------------------------------
+    /// Removes every row.
+    //----------------------------------------------------------------------------------------
+    void clear() noexcept;
+
+    //----------------------------------------------------------------------------------------
+    /// Starts a new row. Its weights are then added with addWeight, and it's closed by endRow.
+    /// @param[in] firstColumn				Column of the first weight of the row.
+    //----------------------------------------------------------------------------------------
+    void beginRow(int firstColumn);
+
+    //----------------------------------------------------------------------------------------
+    /// Appends a weight to the current row, in the column following the previous one.
+    /// @param[in] weight					Weight to append.
+    //----------------------------------------------------------------------------------------
+    void addWeight(float weight);
+
+    //----------------------------------------------------------------------------------------
+    /// Closes the current row, padding it with null weights to a multiple of rowAlignment columns.
+    /// The padding goes before the first column when the row would otherwise end past the last column.
+    /// @param[in] numColumns				Number of columns of the input vectors.
+    //----------------------------------------------------------------------------------------
+    void endRow(int numColumns);
+
+    //----------------------------------------------------------------------------------------
+    /// Computes the product of the matrix with a vector.
+    /// @param[in] inputData				Input vector (numColumns values).
+    /// @param[out] outputData				Output vector (one value for each row).
+    //----------------------------------------------------------------------------------------
+    void apply(const float* inputData, float* outputData) const noexcept;
+
+    //----------------------------------------------------------------------------------------
+    /// Returns the number of rows.
+    //----------------------------------------------------------------------------------------
+    int getNumRows() const noexcept;
+
+private:
+    std::vector<int> m_rowOffsets;			/// Index of the first weight of each row (one extra entry marks the end of the last row).
+    std::vector<int> m_firstColumns;		/// Column of the first weight of each row.
+    std::vector<float> m_weights;			/// Weights, row after row.
+};
\ No newline at end of file
@@ -0,0 +1,144 @@
+//--------------------------------------------------------------------------------------------
+// Name: SpectralAverager.cpp
+// Author: Jérémi Panneton
+// Creation date: October 16th, 2026
+//--------------------------------------------------------------------------------------------
+
+#include "SpectralAverager.h"
+
+bool SpectralAverager::Settings::operator==(const Settings& other) const noexcept
+{
+    return mode == other.mode
+        && boxcarDepth == other.boxcarDepth
+        && timeConstant == other.timeConstant
+        && attackTime == other.attackTime
+        && releaseTime == other.releaseTime
+        && holdTime == other.holdTime;
+}
+
+bool SpectralAverager::Settings::operator!=(const Settings& other) const noexcept
+{
+    return !(*this == other);
+}
+
+SpectralAverager::SpectralAverager(int numChannels, int maxBins)
+    : m_numChannels(numChannels)
+    , m_numBins(maxBins)
+    , m_history(numChannels * maxBoxcarDepth, maxBins)
+    , m_output(numChannels, maxBins)
+    , m_holdCounters(numChannels, maxBins)
+{
+    reset(maxBins);
+}
+
+void SpectralAverager::setSettings(const Settings& settings)
+{
+    if (settings == m_settings)
+        return;
+
+    Settings newSettings = settings;
+    newSettings.boxcarDepth = jlimit(1, static_cast<int>(maxBoxcarDepth), settings.boxcarDepth);
+
+    // The averaged output of one mode is meaningless to another one
+    const bool needsReset = newSettings.mode != m_settings.mode || newSettings.boxcarDepth != m_settings.boxcarDepth;
+    m_settings = newSettings;
+
+    updateCoefficients();
+    if (needsReset)
+    {
+        reset(m_numBins);
+    }
+}
+
+void SpectralAverager::setFrameDuration(double duration)
+{
+    if (duration != m_frameDuration)
+    {
+        m_frameDuration = duration;
+        updateCoefficients();
+    }
+}
+
+void SpectralAverager::reset(int numBins)
+{
+    jassert(numBins <= m_output.getNumSamples());
+    m_numBins = numBins;
+    m_history.clear();
+    m_output.clear();
+    m_holdCounters.clear();
+    m_historyPtr = 0;
+}
+
+const float* SpectralAverager::process(int channel, const float* magnitudes)
+{
+    jassert(channel >= 0 && channel < m_numChannels);
+    float* output = m_output.getWritePointer(channel);
+
+    switch (m_settings.mode)
+    {
+    case Mode::Boxcar:
+    {
+        // Replace the oldest frame of the running sum
+        const int oldestSlot = channel * maxBoxcarDepth + m_historyPtr;
+        float* oldestFrame = m_history.getWritePointer(oldestSlot);
+
+        FloatVectorOperations::subtract(output, oldestFrame, m_numBins);
+        FloatVectorOperations::copyWithMultiply(oldestFrame, magnitudes, 1.0f / m_settings.boxcarDepth, m_numBins);
+        FloatVectorOperations::add(output, oldestFrame, m_numBins);
+        break;
+    }
+    case Mode::Exponential:
+    {
+        // output += coefficient * (magnitudes - output)
+        FloatVectorOperations::multiply(output, 1.0f - m_smoothingCoefficient, m_numBins);
+        FloatVectorOperations::addWithMultiply(output, magnitudes, m_smoothingCoefficient, m_numBins);
+        break;
+    }
+    case Mode::PeakHold:
+    {
+        // Branchless, so that the loop gets vectorized
+        float* holdCounters = m_holdCounters.getWritePointer(channel);
+        const float attackCoefficient = m_attackCoefficient;
+        const float releaseCoefficient = m_releaseCoefficient;
+        const float holdFrames = m_holdFrames;
+
+        for (int bin = 0; bin < m_numBins; ++bin)
+        {
+            const float magnitude = magnitudes[bin];
+            const float level = output[bin];
+            const float holdCounter = holdCounters[bin];
+            const bool isRising = magnitude >= level;
+
+            // A falling level stays still until its hold time has elapsed
+            const float coefficient = isRising ? attackCoefficient : (holdCounter > 0.0f ? 0.0f : releaseCoefficient);
+            output[bin] = level + coefficient * (magnitude - level);
+            holdCounters[bin] = isRising ? holdFrames : holdCounter - 1.0f;
+        }
+        break;
+    }
+    }
+
+    return output;
+}
+
+void SpectralAverager::advance() noexcept
+{
+    if (m_settings.mode == Mode::Boxcar && ++m_historyPtr >= m_settings.boxcarDepth)
+        m_historyPtr = 0;
+}
+
+void SpectralAverager::updateCoefficients()
+{
+    m_smoothingCoefficient = getSmoothingCoefficient(m_settings.timeConstant);
+    m_attackCoefficient = getSmoothingCoefficient(m_settings.attackTime);
+    m_releaseCoefficient = getSmoothingCoefficient(m_settings.releaseTime);
+    m_holdFrames = m_frameDuration > 0.0 ? static_cast<float>(m_settings.holdTime / m_frameDuration) : 0.0f;
+}
+
+float SpectralAverager::getSmoothingCoefficient(float time) const
+{
+    if (time <= 0.0f || m_frameDuration <= 0.0)
+        return 1.0f;
+
+    return static_cast<float>(1.0 - std::exp(-m_frameDuration / time));
+}
\ No newline at end of file
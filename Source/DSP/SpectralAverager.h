@@ -0,0 +1,116 @@
+//--------------------------------------------------------------------------------------------
+// Name: SpectralAverager.h
+// Author: Jérémi Panneton
+// Creation date: October 16th, 2026
+//--------------------------------------------------------------------------------------------
+
+#pragma once
+
+#include "JuceHeader.h"
+
+//--------------------------------------------------------------------------------------------
+/// Smooths consecutive spectral frames over time, bin by bin.
+/// Every mode costs O(1) per bin and per frame, and all the memory is allocated at construction.
+//--------------------------------------------------------------------------------------------
+class SpectralAverager
+{
+public:
+    enum
+    {
+        maxBoxcarDepth = 16
+    };
+
+    //----------------------------------------------------------------------------------------
+    /// Defines how the frames are averaged.
+    //----------------------------------------------------------------------------------------
+    enum class Mode
+    {
+        Boxcar,			/// Mean of the last boxcarDepth frames (running sum).
+        Exponential,	/// One-pole smoothing with a time constant.
+        PeakHold		/// Attack/release ballistics, with each peak held for a while before being released.
+    };
+
+    //----------------------------------------------------------------------------------------
+    /// Averaging parameters. Times are in milliseconds.
+    //----------------------------------------------------------------------------------------
+    struct Settings
+    {
+        bool operator==(const Settings& other) const noexcept;
+        bool operator!=(const Settings& other) const noexcept;
+
+        Mode mode = Mode::Boxcar;		/// Averaging mode.
+        int boxcarDepth = 4;			/// Number of averaged frames (boxcar mode). Gets clipped between 1 and maxBoxcarDepth.
+        float timeConstant = 100.0f;	/// Time needed to reach 63% of a step (exponential mode).
+        float attackTime = 10.0f;		/// Time constant of a rising level (peak hold mode).
+        float releaseTime = 300.0f;		/// Time constant of a falling level once the hold time has elapsed (peak hold mode).
+        float holdTime = 500.0f;		/// Time during which a peak is held before being released (peak hold mode).
+    };
+
+    //----------------------------------------------------------------------------------------
+    /// Constructor.
+    /// @param[in] numChannels				Maximum number of channels to average.
+    /// @param[in] maxBins					Maximum number of bins in a frame.
+    //----------------------------------------------------------------------------------------
+    SpectralAverager(int numChannels, int maxBins);
+
+    //----------------------------------------------------------------------------------------
+    /// Sets the averaging parameters. The averaged output is cleared if the mode or the boxcar depth changes.
+    /// @param[in] settings					Averaging parameters.
+    //----------------------------------------------------------------------------------------
+    void setSettings(const Settings& settings);
+
+    //----------------------------------------------------------------------------------------
+    /// Sets the time between two consecutive frames, which the time constants are based on.
+    /// @param[in] duration					Frame duration (hop size) in milliseconds.
+    //----------------------------------------------------------------------------------------
+    void setFrameDuration(double duration);
+
+    //----------------------------------------------------------------------------------------
+    /// Clears the averaged output and sets the number of bins of the upcoming frames.
+    /// @param[in] numBins					Number of bins in a frame. Should be less or equal to maxBins.
+    //----------------------------------------------------------------------------------------
+    void reset(int numBins);
+
+    //----------------------------------------------------------------------------------------
+    /// Adds a frame to the average of the specified channel.
+    /// @param[in] channel					Averaged channel.
+    /// @param[in] magnitudes				Magnitudes of the frame (numBins values).
+    /// @return								Averaged magnitudes (numBins values). Valid until the next call for this channel.
+    //----------------------------------------------------------------------------------------
+    const float* process(int channel, const float* magnitudes);
+
+    //----------------------------------------------------------------------------------------
+    /// Moves on to the next frame. Should be called once all the channels of a frame are processed.
+    //----------------------------------------------------------------------------------------
+    void advance() noexcept;
+
+private:
+    //----------------------------------------------------------------------------------------
+    /// Computes the smoothing coefficients from the time constants and the frame duration.
+    //----------------------------------------------------------------------------------------
+    void updateCoefficients();
+
+    //----------------------------------------------------------------------------------------
+    /// Returns the coefficient of a one-pole smoother reaching 63% of a step in the specified time.
+    /// @param[in] time						Time constant in milliseconds.
+    /// @return								Smoothing coefficient (between 0 and 1). 1 means no smoothing.
+    //----------------------------------------------------------------------------------------
+    float getSmoothingCoefficient(float time) const;
+
+    const int m_numChannels;				/// Maximum number of channels.
+    int m_numBins;							/// Number of bins in a frame.
+
+    AudioBuffer<float> m_history;			/// Last frames of each channel, divided by the depth (boxcar mode). maxBoxcarDepth channels per averaged channel.
+    AudioBuffer<float> m_output;			/// Averaged output of each channel (the running sum in boxcar mode, the smoother state otherwise).
+    AudioBuffer<float> m_holdCounters;		/// Remaining frames before each peak gets released (peak hold mode).
+    int m_historyPtr = 0;					/// Index of the oldest frame in the history.
+
+    Settings m_settings;					/// Current averaging parameters.
+    double m_frameDuration = 0.0;			/// Time between two consecutive frames in milliseconds.
+    float m_smoothingCoefficient = 1.0f;	/// Coefficient of the exponential mode.
+    float m_attackCoefficient = 1.0f;		/// Coefficient of a rising level (peak hold mode).
+    float m_releaseCoefficient = 1.0f;		/// Coefficient of a falling level (peak hold mode).
+    float m_holdFrames = 0.0f;				/// Number of frames during which a peak is held (peak hold mode).
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SpectralAverager)
+};
\ No newline at end of file
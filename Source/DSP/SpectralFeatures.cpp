@@ -0,0 +1,163 @@
+//--------------------------------------------------------------------------------------------
+// Name: SpectralFeatures.cpp
+// Author: Jérémi Panneton
+// Creation date: October 16th, 2026
+//--------------------------------------------------------------------------------------------
+
+#include "SpectralFeatures.h"
+#include "FastDecibels.h"
+
+namespace
+{
+    constexpr float minMagnitude = 1.0e-10f; // -200 dB, keeps the logarithm of silent values finite (flatness)
+    constexpr int rolloffBlockSize = 16;	// Values added up at once while looking for the rolloff
+
+#if FAST_DECIBELS_USE_SSE
+    float horizontalSum(__m128 values) noexcept
+    {
+        values = _mm_add_ps(values, _mm_movehl_ps(values, values));
+        return _mm_cvtss_f32(_mm_add_ss(values, _mm_shuffle_ps(values, values, _MM_SHUFFLE(1, 1, 1, 1))));
+    }
+
+    float horizontalMax(__m128 values) noexcept
+    {
+        values = _mm_max_ps(values, _mm_movehl_ps(values, values));
+        return _mm_cvtss_f32(_mm_max_ss(values, _mm_shuffle_ps(values, values, _MM_SHUFFLE(1, 1, 1, 1))));
+    }
+#endif
+}
+
+SpectralFeatureExtractor::SpectralFeatureExtractor(int maxChannels, int maxValues)
+    : m_maxValues(maxValues)
+    , m_previousMagnitudes(maxChannels, maxValues)
+    , m_numPreviousValues(static_cast<size_t>(maxChannels))
+{
+    reset();
+}
+
+void SpectralFeatureExtractor::reset() noexcept
+{
+    for (int channel = 0; channel < m_previousMagnitudes.getNumChannels(); ++channel)
+        m_numPreviousValues[channel] = 0;
+}
+
+void SpectralFeatureExtractor::process(int channel, const float* magnitudes, const float* frequencies, int numValues, SpectralFeatures& features) noexcept
+{
+    jassert(channel >= 0 && channel < m_previousMagnitudes.getNumChannels());
+    jassert(numValues > 0 && numValues <= m_maxValues);
+
+    float* previous = m_previousMagnitudes.getWritePointer(channel);
+    // Without a previous spectrum of the same layout, the current one is compared to itself (no flux)
+    if (m_numPreviousValues[channel] != numValues)
+        FloatVectorOperations::copy(previous, magnitudes, numValues);
+
+    float sum = 0.0f;
+    float weightedSum = 0.0f;
+    float logSum = 0.0f;
+    float maxMagnitude = 0.0f;
+    float squaredFlux = 0.0f;
+    int i = 0;
+
+    // Single pass: every sum is accumulated while the values are in registers, and the previous spectrum is updated in place
+#if FAST_DECIBELS_USE_SSE
+    {
+        // Each lane has its own accumulators, which are only added together after the loop
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 minMagnitudes = _mm_set1_ps(minMagnitude);
+        __m128 sums = zero;
+        __m128 weightedSums = zero;
+        __m128 logSums = zero;
+        __m128 maxMagnitudes = zero;
+        __m128 squaredFluxes = zero;
+
+        for (; i + 4 <= numValues; i += 4)
+        {
+            const __m128 magnitude = _mm_loadu_ps(magnitudes + i);
+            const __m128 increase = _mm_max_ps(zero, _mm_sub_ps(magnitude, _mm_loadu_ps(previous + i)));
+
+            sums = _mm_add_ps(sums, magnitude);
+            weightedSums = _mm_add_ps(weightedSums, _mm_mul_ps(magnitude, _mm_loadu_ps(frequencies + i)));
+            logSums = _mm_add_ps(logSums, fastLog2(_mm_max_ps(minMagnitudes, magnitude)));
+            maxMagnitudes = _mm_max_ps(maxMagnitudes, magnitude);
+            squaredFluxes = _mm_add_ps(squaredFluxes, _mm_mul_ps(increase, increase));
+
+            _mm_storeu_ps(previous + i, magnitude);
+        }
+
+        sum = horizontalSum(sums);
+        weightedSum = horizontalSum(weightedSums);
+        logSum = horizontalSum(logSums);
+        maxMagnitude = horizontalMax(maxMagnitudes);
+        squaredFlux = horizontalSum(squaredFluxes);
+    }
+#endif
+
+    for (; i < numValues; ++i)
+    {
+        const float magnitude = magnitudes[i];
+        const float increase = jmax(0.0f, magnitude - previous[i]);
+
+        sum += magnitude;
+        weightedSum += magnitude * frequencies[i];
+        logSum += fastLog2(jmax(minMagnitude, magnitude));
+        maxMagnitude = jmax(maxMagnitude, magnitude);
+        squaredFlux += increase * increase;
+
+        previous[i] = magnitude;
+    }
+
+    m_numPreviousValues[channel] = numValues;
+    features.flux = std::sqrt(squaredFlux);
+
+    if (sum <= 0.0f)
+    {
+        // Silence has no shape
+        features.centroid = 0.0f;
+        features.rolloff = 0.0f;
+        features.flatness = 0.0f;
+        features.crest = 0.0f;
+        return;
+    }
+
+    const float mean = sum / numValues;
+    features.centroid = weightedSum / sum;
+    features.flatness = jmin(1.0f, std::exp2(logSum / numValues) / mean);
+    features.crest = maxMagnitude / mean;
+
+    features.rolloff = frequencies[findPartialSumIndex(magnitudes, numValues, rolloffRatio * sum)];
+}
+
+int SpectralFeatureExtractor::findPartialSumIndex(const float* magnitudes, int numValues, float target) noexcept
+{
+    float partialSum = 0.0f;
+    int i = 0;
+
+    // Whole blocks are skipped while the target is out of their reach
+    for (; i + rolloffBlockSize <= numValues; i += rolloffBlockSize)
+    {
+#if FAST_DECIBELS_USE_SSE
+        const __m128 firstHalf = _mm_add_ps(_mm_loadu_ps(magnitudes + i), _mm_loadu_ps(magnitudes + i + 4));
+        const __m128 secondHalf = _mm_add_ps(_mm_loadu_ps(magnitudes + i + 8), _mm_loadu_ps(magnitudes + i + 12));
+        const float blockSum = horizontalSum(_mm_add_ps(firstHalf, secondHalf));
+#else
+        float blockSum = 0.0f;
+        for (int j = 0; j < rolloffBlockSize; ++j)
+            blockSum += magnitudes[i + j];
+#endif
+
+        if (partialSum + blockSum >= target)
+            break;
+
+        partialSum += blockSum;
+    }
+
+    // The target is reached within the current block (or the remaining values)
+    for (; i < numValues; ++i)
+    {
+        partialSum += magnitudes[i];
+        if (partialSum >= target)
+            return i;
+    }
+
+    return numValues - 1;
+}
\ No newline at end of file
@@ -0,0 +1,71 @@
+//--------------------------------------------------------------------------------------------
+// Name: SpectralFeatures.h
+// Author: Jérémi Panneton
+// Creation date: October 16th, 2026
+//--------------------------------------------------------------------------------------------
+
+#pragma once
+
+#include "JuceHeader.h"
+
+//--------------------------------------------------------------------------------------------
+/// Descriptors of the shape of a magnitude spectrum.
+//--------------------------------------------------------------------------------------------
+struct SpectralFeatures
+{
+    float centroid = 0.0f;	/// Center of mass of the magnitudes, in Hz (brightness).
+    float flux = 0.0f;		/// Euclidean norm of the magnitude increases since the previous frame (onsets).
+    float rolloff = 0.0f;	/// Frequency below which lies rolloffRatio of the total magnitude, in Hz.
+    float flatness = 0.0f;	/// Geometric mean over arithmetic mean of the magnitudes, between 0 (tonal) and 1 (white noise).
+    float crest = 0.0f;		/// Maximum over arithmetic mean of the magnitudes (1 for a flat spectrum, large for a single peak).
+};
+
+//--------------------------------------------------------------------------------------------
+/// Computes the spectral features of consecutive magnitude spectra.
+/// Every sum is accumulated in a single pass over the values, four lanes at a time with SSE (scalar otherwise).
+/// The rolloff is then found by a second scan of the partial sums, block by block, which stops at the rolloff block.
+//--------------------------------------------------------------------------------------------
+class SpectralFeatureExtractor
+{
+public:
+    static constexpr float rolloffRatio = 0.85f;
+
+    //----------------------------------------------------------------------------------------
+    /// Constructor. Allocates the history of every channel.
+    /// @param[in] maxChannels				Maximum number of channels.
+    /// @param[in] maxValues				Maximum number of values in a spectrum.
+    //----------------------------------------------------------------------------------------
+    SpectralFeatureExtractor(int maxChannels, int maxValues);
+
+    //----------------------------------------------------------------------------------------
+    /// Clears the previous spectra, so the next flux of each channel is 0. Should be called whenever the layout of the values changes.
+    //----------------------------------------------------------------------------------------
+    void reset() noexcept;
+
+    //----------------------------------------------------------------------------------------
+    /// Computes the features of a spectrum.
+    /// The sums are accumulated in a different order than a plain loop would, so they may differ in the last bits.
+    /// @param[in] channel					Channel of the spectrum (each channel has its own previous spectrum for the flux).
+    /// @param[in] magnitudes				Linear magnitudes of the spectrum.
+    /// @param[in] frequencies				Frequency of each magnitude (increasing).
+    /// @param[in] numValues				Number of magnitudes in the spectrum.
+    /// @param[out] features				Computed features.
+    //----------------------------------------------------------------------------------------
+    void process(int channel, const float* magnitudes, const float* frequencies, int numValues, SpectralFeatures& features) noexcept;
+
+private:
+    //----------------------------------------------------------------------------------------
+    /// Returns the index of the first value at which the running sum of the magnitudes reaches a target.
+    /// @param[in] magnitudes				Linear magnitudes of the spectrum.
+    /// @param[in] numValues				Number of magnitudes in the spectrum.
+    /// @param[in] target					Running sum to reach.
+    /// @return								Index of the value (the last one if the target is never reached).
+    //----------------------------------------------------------------------------------------
+    static int findPartialSumIndex(const float* magnitudes, int numValues, float target) noexcept;
+
+    const int m_maxValues;							/// Maximum number of values in a spectrum.
+    AudioBuffer<float> m_previousMagnitudes;		/// Previous spectrum of each channel (flux).
+    HeapBlock<int> m_numPreviousValues;				/// Number of values in the previous spectrum of each channel (0 if none).
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SpectralFeatureExtractor)
+};
\ No newline at end of file
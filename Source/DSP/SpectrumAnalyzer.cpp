@@ -0,0 +1,1216 @@
+//--------------------------------------------------------------------------------------------
+// Name: SpectrumAnalyzer.cpp
+// Author: Jérémi Panneton
+// Creation date: October 16th, 2026
+//--------------------------------------------------------------------------------------------
+
+#include "SpectrumAnalyzer.h"
+#include "FastDecibels.h"
+#include "RangeMax.h"
+#include <cstring>
+
+SpectrumAnalyzer::SpectrumAnalyzer(StereoRingBuffer& ringBuffer, int ringReader, AudioBuffer<float>& readBuffer, double sampleRate, int outputResolution,
+                                   FFTBackend::Type fftBackend)
+    : Thread("Spectrum Analyzer")
+    , m_ringBuffer(ringBuffer)
+    , m_ringReader(ringReader)
+    , m_readBuffer(readBuffer)
+    , m_sampleRate(sampleRate)
+    , m_analysisRate(sampleRate)
+    , m_decimator(maxChannels, maxDecimationFactor, maxFftSize)
+    , m_decimatedData(maxChannels, maxFftSize)
+    , m_fftData(2 * maxFftSize, true)
+    , m_spectrumData(maxFftSize, true)
+    , m_visuData(maxChannels * outputResolution, true)
+    , m_mixedData(maxFftSize, true)
+    , m_reassignmentSpectra(3 * maxFftSize, true)
+    , m_reassignedFrequencies(maxChannels * outputResolution, true)
+    , m_averager(maxChannels, maxFftSize / 2)
+    , m_binLevels(maxFftSize / 2, true)
+    , m_binFrequencies(maxFftSize / 2, true)
+    , m_featureExtractor(maxChannels, jmax(static_cast<int>(maxFftSize / 2), outputResolution))
+    , m_levelRangeTracker(maxChannels)
+    , m_frequencyAxis(outputResolution, 20.0f, static_cast<float>(sampleRate) / 2) // Nyquist frequency
+    , m_interpolationMatrix(outputResolution)
+    , m_filterbank(outputResolution, maxFftSize / 2)
+    , m_frameQueue(frameQueueSize, SpectralFrame(outputResolution, maxChannels))
+    , m_featureHistory(featureHistorySize)
+    , m_hopSize(defaultHopSize)
+    , m_fftOrder(defaultFftOrder)
+    , m_maxFrequency(static_cast<float>(sampleRate) / 2)
+    , m_kaiserBeta(defaultKaiserBeta)
+    , m_averagingDepth(SpectralAverager::Settings().boxcarDepth)
+    , m_averagingTime(SpectralAverager::Settings().timeConstant)
+    , m_attackTime(SpectralAverager::Settings().attackTime)
+    , m_releaseTime(SpectralAverager::Settings().releaseTime)
+    , m_holdTime(SpectralAverager::Settings().holdTime)
+    , m_currentMaxFrequency(static_cast<float>(sampleRate) / 2)
+{
+    jassert(m_readBuffer.getNumSamples() >= maxFftSize);
+    jassert(m_readBuffer.getNumChannels() == maxChannels);
+    m_decimatedData.clear();
+
+    // Preallocate every plan, so that switching the FFT size never allocates (the backends are also selected here)
+    for (int order = minFftOrder; order <= maxFftOrder; ++order)
+    {
+        m_plans.push_back(std::make_unique<FFTPlan>(order, fftBackend));
+    }
+
+    for (int channel = 0; channel < maxChannels; ++channel)
+    {
+        m_watchedBanks.push_back(std::make_unique<SlidingDFTBank>(maxFftSize));
+    }
+
+    // Mains hum (50 Hz) and its harmonics
+    float humFrequencies[12];
+    for (int harmonic = 0; harmonic < 12; ++harmonic)
+    {
+        humFrequencies[harmonic] = 50.0f * (harmonic + 1);
+    }
+    setWatchedFrequencies(humFrequencies, 12);
+
+    m_plan = m_plans[defaultFftOrder - minFftOrder].get();
+    updateWindow();
+    resetHistory();
+
+    m_binRanges.reserve(static_cast<size_t>(outputResolution));
+    updateFrequencyMapping();
+}
+
+SpectrumAnalyzer::~SpectrumAnalyzer()
+{
+    stop();
+}
+
+void SpectrumAnalyzer::start()
+{
+    stop();
+    m_frameQueue.clear();
+    startThread();
+}
+
+void SpectrumAnalyzer::stop()
+{
+    stopThread(1000);
+}
+
+void SpectrumAnalyzer::setMaxFrequency(float frequency)
+{
+    m_maxFrequency = frequency;
+}
+
+void SpectrumAnalyzer::setFrequencyDistribution(FrequencyAxis<float>::Distribution distribution)
+{
+    m_distribution = distribution;
+}
+
+void SpectrumAnalyzer::setAdaptiveLevel(bool enabled)
+{
+    m_adaptativeLevel = enabled;
+}
+
+void SpectrumAnalyzer::setClipLevel(bool enabled)
+{
+    m_clipLevel = enabled;
+}
+
+void SpectrumAnalyzer::setHopSize(int hopSize)
+{
+    m_hopSize = jlimit(1, static_cast<int>(maxFftSize), hopSize);
+}
+
+void SpectrumAnalyzer::setFftOrder(int order)
+{
+    m_fftOrder = jlimit(static_cast<int>(minFftOrder), static_cast<int>(maxFftOrder), order);
+}
+
+void SpectrumAnalyzer::setChannelMode(ChannelMode mode)
+{
+    m_channelMode = mode;
+}
+
+void SpectrumAnalyzer::setTransformMode(TransformMode mode)
+{
+    m_transformMode = mode;
+}
+
+void SpectrumAnalyzer::setWatchedFrequencies(const float* frequencies, int numFrequencies)
+{
+    jassert(numFrequencies <= SlidingDFTBank::maxFrequencies);
+    numFrequencies = jmin(numFrequencies, static_cast<int>(SlidingDFTBank::maxFrequencies));
+
+    for (int i = 0; i < numFrequencies; ++i)
+        m_watchedFrequencies[i] = frequencies[i];
+
+    m_numWatchedFrequencies = numFrequencies;
+    ++m_watchedVersion;
+}
+
+void SpectrumAnalyzer::setAveraging(const SpectralAverager::Settings& settings)
+{
+    m_averagingMode = settings.mode;
+    m_averagingDepth = settings.boxcarDepth;
+    m_averagingTime = settings.timeConstant;
+    m_attackTime = settings.attackTime;
+    m_releaseTime = settings.releaseTime;
+    m_holdTime = settings.holdTime;
+}
+
+void SpectrumAnalyzer::setWindow(WindowType type, float kaiserBeta)
+{
+    m_kaiserBeta = kaiserBeta;
+    m_windowType = type;
+}
+
+void SpectrumAnalyzer::setNoiseLevelCorrection(bool enabled)
+{
+    m_noiseLevelCorrection = enabled;
+}
+
+void SpectrumAnalyzer::setPartialTracking(bool enabled)
+{
+    m_partialTracking = enabled;
+}
+
+void SpectrumAnalyzer::setLatencyPolicy(LatencyPolicy policy, int maxFrames, double timeBudget)
+{
+    jassert(maxFrames > 0 && timeBudget >= 0.0);
+    m_maxPendingFrames = jmax(1, maxFrames);
+    m_timeBudget = jmax(0.0, timeBudget);
+    m_latencyPolicy = policy;
+}
+
+int SpectrumAnalyzer::getFftSize() const noexcept
+{
+    return 1 << m_fftOrder.load();
+}
+
+SpectrumAnalyzer::FFTPlan::FFTPlan(int order, FFTBackend::Type backend)
+    : fftOrder(order)
+    , fftSize(1 << order)
+    , fftBins(fftSize >> 1)
+    , forwardFFT(FFTBackend::create(backend, order))
+    , halfFFT(FFTBackend::create(backend, order - 1))
+    , twiddles(static_cast<size_t>(fftBins))
+{
+    for (int k = 0; k < fftBins; ++k)
+    {
+        twiddles[k] = std::polar(1.0f, -MathConstants<float>::twoPi * k / fftSize);
+    }
+
+    for (int type = 0; type < numWindowTypes; ++type)
+    {
+        windows.push_back(std::make_unique<WindowTables>(fftSize));
+        windows.back()->fill(static_cast<WindowType>(type), defaultKaiserBeta);
+    }
+}
+
+SpectrumAnalyzer::WindowTables::WindowTables(int fftSize)
+    : size(fftSize)
+    , window(static_cast<size_t>(fftSize))
+    , derivativeWindow(static_cast<size_t>(fftSize))
+    , timeWeightedWindow(static_cast<size_t>(fftSize))
+{
+}
+
+void SpectrumAnalyzer::WindowTables::fill(WindowType type, float kaiserBeta)
+{
+    using Windowing = dsp::WindowingFunction<float>;
+    constexpr Windowing::WindowingMethod methods[] = { Windowing::hann, Windowing::blackmanHarris, Windowing::flatTop, Windowing::kaiser };
+
+    // Not normalized, since the levels are corrected by the coherent gain instead
+    Windowing::fillWindowingTables(window, static_cast<size_t>(size), methods[static_cast<int>(type)], false, kaiserBeta);
+    beta = kaiserBeta;
+
+    // Central differences (one-sided at both ends), so that any window table can be derived
+    const float center = 0.5f * (size - 1);
+    double sum = 0.0;
+    double squaredSum = 0.0;
+    for (int i = 0; i < size; ++i)
+    {
+        const int previous = jmax(0, i - 1);
+        const int next = jmin(size - 1, i + 1);
+        derivativeWindow[i] = (window[next] - window[previous]) / (next - previous);
+        timeWeightedWindow[i] = (i - center) * window[i];
+
+        sum += window[i];
+        squaredSum += window[i] * window[i];
+    }
+
+    // ENBW = N * sum(w^2) / sum(w)^2
+    coherentGain = static_cast<float>(sum / size);
+    noiseBandwidth = static_cast<float>(size * squaredSum / (sum * sum));
+}
+
+String SpectrumAnalyzer::getFftBackendNames() const
+{
+    const auto& plan = *m_plans[static_cast<size_t>(m_fftOrder - minFftOrder)];
+    return String(plan.forwardFFT->getName()) + " / " + String(plan.halfFFT->getName());
+}
+
+int SpectrumAnalyzer::getResolution() const noexcept
+{
+    return m_frequencyAxis.getResolution();
+}
+
+const HistoryBuffer<SpectrumAnalyzer::FeatureSnapshot>& SpectrumAnalyzer::getFeatureHistory() const noexcept
+{
+    return m_featureHistory;
+}
+
+bool SpectrumAnalyzer::popFrame(SpectralFrame& frame)
+{
+    return m_frameQueue.pop([&](const SpectralFrame& finishedFrame)
+    {
+        // Same size, so no reallocation is being done
+        frame = finishedFrame;
+    });
+}
+
+void SpectrumAnalyzer::run()
+{
+    while (!threadShouldExit())
+    {
+        // Turn the available hops into spectral frames, batch after batch until the backlog is handled
+        while (!threadShouldExit() && processPendingFrames() > 0)
+        {
+        }
+
+        // Wait for roughly half a hop of new audio data. Polling is used instead of a notification
+        // so that the audio thread never has to signal (and potentially lock) anything.
+        const double hopDuration = 1000.0 * m_hopSize / m_sampleRate;
+        wait(jmax(1, static_cast<int>(hopDuration / 2)));
+    }
+}
+
+void SpectrumAnalyzer::applyParameters()
+{
+    // The frequency mapping depends on both the axis layout and the number of bins
+    bool mappingChanged = false;
+
+    const float maxFrequency = m_maxFrequency;
+    if (maxFrequency != m_currentMaxFrequency)
+    {
+        m_currentMaxFrequency = maxFrequency;
+        m_frequencyAxis.setMaxFrequency(maxFrequency);
+        mappingChanged = true;
+
+        const int decimationFactor = getDecimationFactor(maxFrequency);
+        if (decimationFactor != m_decimator.getFactor())
+        {
+            // The decimated history and the averaged output belong to the previous rate
+            m_decimator.setFactor(decimationFactor);
+            m_analysisRate = m_sampleRate / decimationFactor;
+            m_decimatedData.clear();
+            resetHistory();
+        }
+    }
+
+    const auto distribution = m_distribution.load();
+    if (distribution != m_frequencyAxis.getDistribution())
+    {
+        // The values of the axis still have the same layout, only their frequencies change
+        m_frequencyAxis.setDistribution(distribution);
+        mappingChanged = true;
+    }
+
+    const int fftOrder = m_fftOrder;
+    if (fftOrder != m_plan->fftOrder)
+    {
+        // The averaged output of the new plan is outdated
+        m_plan = m_plans[fftOrder - minFftOrder].get();
+        resetHistory();
+        m_decimatedData.clear();
+        mappingChanged = true;
+    }
+
+    const TransformMode transformMode = m_transformMode;
+    if (transformMode != m_currentTransformMode)
+    {
+        // The averaged output doesn't hold the same values anymore (bins or frequencies of the axis)
+        m_currentTransformMode = transformMode;
+        resetHistory();
+        mappingChanged = true;
+    }
+
+    const uint32 watchedVersion = m_watchedVersion;
+    if (watchedVersion != m_currentWatchedVersion && m_currentTransformMode == TransformMode::Watched)
+    {
+        // The banks are rebuilt along with the mapping
+        m_currentWatchedVersion = watchedVersion;
+        resetHistory();
+        mappingChanged = true;
+    }
+
+    const WindowType windowType = m_windowType;
+    const bool kaiserChanged = windowType == WindowType::Kaiser && m_kaiserBeta != m_plan->windows[static_cast<int>(windowType)]->beta;
+    if (windowType != m_currentWindowType || kaiserChanged)
+    {
+        // The averaged magnitudes were computed with another window
+        m_currentWindowType = windowType;
+        resetHistory();
+    }
+
+    // Also done when the plan or the transform mode changes (the correction doesn't apply to the constant-Q kernels)
+    updateWindow();
+
+    if (mappingChanged)
+    {
+        updateFrequencyMapping();
+    }
+
+    const ChannelMode channelMode = m_channelMode;
+    if (channelMode != m_currentChannelMode)
+    {
+        // The averaged output doesn't match the new channels anymore, and the decimated frame may hold the previous mix
+        m_currentChannelMode = channelMode;
+        m_decimator.reset();
+        m_decimatedData.clear();
+        resetHistory();
+    }
+
+    SpectralAverager::Settings averaging;
+    averaging.mode = m_averagingMode;
+    averaging.boxcarDepth = m_averagingDepth;
+    averaging.timeConstant = m_averagingTime;
+    averaging.attackTime = m_attackTime;
+    averaging.releaseTime = m_releaseTime;
+    averaging.holdTime = m_holdTime;
+    m_averager.setSettings(averaging);
+
+    const bool partialTracking = m_partialTracking;
+    if (partialTracking != m_currentPartialTracking)
+    {
+        // Tracks left from a previous session would be linked to unrelated peaks
+        m_currentPartialTracking = partialTracking;
+        for (auto& partialTracker : m_partialTrackers)
+            partialTracker.reset();
+    }
+}
+
+int SpectrumAnalyzer::processPendingFrames()
+{
+    // Apply pending parameters between two batches
+    applyParameters();
+
+    const int fftSize = m_plan->fftSize;
+    const int decimationFactor = m_decimator.getFactor();
+    // The hop size is given at the original rate, but the frame is made of decimated samples
+    const int hopSize = jlimit(jmax(1, fftSize / (16 * decimationFactor)), fftSize, m_hopSize.load() / decimationFactor);
+
+    // Audio samples consumed by each hop, and needed by the first one (the decimated frames keep their own history)
+    const int hopSamples = hopSize * decimationFactor;
+    const int firstHopSamples = decimationFactor == 1 ? fftSize : hopSamples;
+    const int numReady = m_ringBuffer.getNumReady(m_ringReader);
+    int numPending = numReady < firstHopSamples ? 0 : 1 + (numReady - firstHopSamples) / hopSamples;
+
+    const LatencyPolicy policy = m_latencyPolicy;
+    const int maxPendingFrames = m_maxPendingFrames;
+    if (policy == LatencyPolicy::NewestFrames && numPending > maxPendingFrames)
+    {
+        // Skip the oldest hops, so that the display only lags by the newest ones
+        m_ringBuffer.skipSamples((numPending - maxPendingFrames) * hopSamples, m_ringReader);
+        numPending = maxPendingFrames;
+    }
+
+    const int64 budgetTicks = static_cast<int64>(m_timeBudget / 1000.0 * Time::getHighResolutionTicksPerSecond());
+    const int64 startTicks = Time::getHighResolutionTicks();
+    int numProcessed = 0;
+
+    while (numProcessed < numPending && !threadShouldExit())
+    {
+        // Leave the audio data in the ring buffer until the rendering thread catches up
+        if (!processNextFrame(fftSize, hopSize))
+            break;
+
+        ++numProcessed;
+
+        if (policy == LatencyPolicy::TimeBudget && numProcessed < numPending && Time::getHighResolutionTicks() - startTicks >= budgetTicks)
+        {
+            // Out of time: skip to the newest hop, which the next batch starts with
+            m_ringBuffer.skipSamples((numPending - numProcessed - 1) * hopSamples, m_ringReader);
+            break;
+        }
+    }
+
+    return numProcessed;
+}
+
+bool SpectrumAnalyzer::processNextFrame(int fftSize, int hopSize)
+{
+    // Leave the audio data in the ring buffer until the rendering thread catches up
+    if (m_frameQueue.getFreeSpace() == 0)
+        return false;
+
+    const int fftBins = m_plan->fftBins;
+    const int decimationFactor = m_decimator.getFactor();
+
+    FrameRegions frame;
+    StereoRingBuffer::ReadView view;
+    int64 endSample = 0;
+    if (decimationFactor == 1)
+    {
+        // The frame is analyzed straight from the ring buffer, which keeps it until the hop is committed
+        if (!m_ringBuffer.peekSamples(fftSize, view, m_ringReader))
+            return false;
+
+        endSample = view.getStartPosition() + fftSize;
+
+        for (int channel = 0; channel < maxChannels; ++channel)
+        {
+            frame.data[0][channel] = view.getRegion1(channel);
+            frame.data[1][channel] = view.getRegion2(channel);
+        }
+
+        frame.sizes[0] = view.getSize1();
+        frame.sizes[1] = view.getSize2();
+    }
+    else
+    {
+        // The decimated frame ends with the hop that is read
+        if (!readDecimatedHop(fftSize, hopSize, endSample))
+            return false;
+
+        for (int channel = 0; channel < maxChannels; ++channel)
+        {
+            frame.data[0][channel] = m_decimatedData.getReadPointer(channel, maxFftSize - fftSize);
+            frame.data[1][channel] = nullptr;
+        }
+
+        frame.sizes[0] = fftSize;
+        frame.sizes[1] = 0;
+        frame.premixed = m_currentChannelMode != ChannelMode::Dual;
+    }
+
+    const int resolution = m_frequencyAxis.getResolution();
+    const bool constantQ = m_currentTransformMode == TransformMode::ConstantQ;
+    const bool reassigned = m_currentTransformMode == TransformMode::Reassigned;
+    const bool watched = m_currentTransformMode == TransformMode::Watched;
+    const bool axisValues = constantQ || reassigned || watched;
+    const int numChannels = m_currentChannelMode == ChannelMode::Dual ? 2 : 1;
+    // Values handed to the averager for each channel: FFT bins, or directly the frequencies of the axis
+    const float* transformedData = axisValues ? m_visuData.getData() : m_fftData.getData();
+    const int numValues = axisValues ? resolution : fftBins;
+
+    if (reassigned)
+    {
+        reassignFrame(frame, fftSize, hopSize);
+    }
+    else if (watched)
+    {
+        watchFrequencies(frame, fftSize, hopSize);
+    }
+    else if (constantQ)
+    {
+        // The constant-Q kernels are windowed on their own, so the frame is left unwindowed
+        const auto* spectra = computeSpectra(frame, nullptr, fftSize);
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            m_constantQKernel.apply(spectra + channel * fftBins, m_visuData + channel * resolution);
+        }
+    }
+    else
+    {
+        // Window the channels and perform the FFT
+        transformFrame(frame, fftSize);
+
+        // Normalize the magnitudes, so that the levels don't depend on the FFT size
+        FloatVectorOperations::multiply(m_fftData, 1.0f / fftBins, numChannels * fftBins);
+    }
+
+    // Release the hop. If the writer has overwritten the frame in the meantime, it's discarded.
+    if (decimationFactor == 1 && !m_ringBuffer.commitRead(view, hopSize))
+    {
+        // The sliding DFTs have already been fed the discarded hop, so they start over with the next frame
+        if (watched)
+        {
+            for (auto& watchedBank : m_watchedBanks)
+                watchedBank->reset();
+
+            m_watchedBanksFilled = false;
+        }
+
+        return false;
+    }
+
+    m_averager.setFrameDuration(1000.0 * hopSize * decimationFactor / m_sampleRate);
+    m_levelRangeTracker.setFrameDuration(1000.0 * hopSize * decimationFactor / m_sampleRate);
+
+    // Features are gathered along with the columns, and published once the frame is
+    FeatureSnapshot features;
+    features.numChannels = numChannels;
+
+    // Publish the finished columns (there is free space, since this thread is the only writer)
+    const bool pushed = m_frameQueue.push([&](SpectralFrame& frame)
+    {
+        frame.numChannels = numChannels;
+        frame.startSample = endSample - static_cast<int64>(fftSize) * decimationFactor;
+        frame.endSample = endSample;
+
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            // Average FFT output to smooth frequency resolution (Welch's method)
+            const float* averagedData = m_averager.process(channel, transformedData + channel * numValues);
+
+            // Find the range of values produced, so we can scale our rendering to show up the detail clearly
+            const auto levelRange = FloatVectorOperations::findMinAndMax(averagedData, numValues);
+            const int offset = channel * resolution;
+
+            if (axisValues)
+            {
+                // Every frequency of the axis has already been computed
+                if (reassigned)
+                {
+                    FloatVectorOperations::copy(frame.frequencies.data() + offset, m_reassignedFrequencies + offset, resolution);
+                }
+                else
+                {
+                    for (int x = 0; x < resolution; ++x)
+                    {
+                        frame.frequencies[offset + x] = m_frequencyAxis[x];
+                    }
+
+                    // The watched frequencies are exact, not rounded to the axis
+                    for (int i = 0; watched && i < m_watchedBanks[0]->getNumFrequencies(); ++i)
+                    {
+                        if (m_watchedRows[i] >= 0)
+                            frame.frequencies[offset + m_watchedRows[i]] = m_watchedBanks[0]->getFrequency(i);
+                    }
+                }
+
+                mapLevels(channel, averagedData, levelRange, frame.dbLevels.data() + offset, frame.normalizedLevels.data() + offset);
+            }
+            else
+            {
+                // Interpolate the latest averaged result
+                interpolateData(averagedData, m_visuData + offset, frame.frequencies.data() + offset);
+
+                mapLevels(channel, m_visuData + offset, levelRange, frame.dbLevels.data() + offset, frame.normalizedLevels.data() + offset);
+            }
+
+            trackPartials(channel, averagedData, frame);
+            extractFeatures(channel, averagedData, frame, features.channels[channel]);
+        }
+
+        // All the channels share the same averager history slot
+        m_averager.advance();
+    });
+
+    if (pushed)
+        m_featureHistory.push(features);
+
+    return pushed;
+}
+
+bool SpectrumAnalyzer::readDecimatedHop(int fftSize, int hopSize, int64& endSample)
+{
+    // Every hop is a multiple of the factor, so the decimator always outputs exactly hopSize samples
+    const int numSamples = hopSize * m_decimator.getFactor();
+    jassert(numSamples <= m_readBuffer.getNumSamples());
+
+    // Decimation is linear, so a single channel mode can decimate its mix instead of every channel
+    const int numChannels = m_currentChannelMode == ChannelMode::Dual ? 2 : 1;
+    // The position of the hop comes with the read, since the writer may push the read position forward right after it
+    int64 startSample = 0;
+    if (numChannels == 1)
+    {
+        float gains[maxChannels];
+        getChannelGains(gains);
+        if (!m_ringBuffer.readMixedSamples(m_readBuffer.getWritePointer(0), gains, numSamples, numSamples, m_ringReader, &startSample))
+            return false;
+    }
+    else if (!m_ringBuffer.readSamples(m_readBuffer, numSamples, numSamples, m_ringReader, &startSample))
+    {
+        return false;
+    }
+
+    endSample = startSample + numSamples;
+
+    // Shift the current frame back to make room for the new samples
+    float* decimatedData[maxChannels];
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        float* frame = m_decimatedData.getWritePointer(channel, maxFftSize - fftSize);
+        std::memmove(frame, frame + hopSize, sizeof(float) * static_cast<size_t>(fftSize - hopSize));
+        decimatedData[channel] = m_decimatedData.getWritePointer(channel, maxFftSize - hopSize);
+    }
+
+    const int numDecimated = m_decimator.process(m_readBuffer.getArrayOfReadPointers(), numChannels, numSamples, decimatedData);
+    jassert(numDecimated == hopSize);
+    ignoreUnused(numDecimated);
+    return true;
+}
+
+void SpectrumAnalyzer::gatherFrame(const FrameRegions& frame, const float** frameData)
+{
+    for (int channel = 0; channel < maxChannels; ++channel)
+    {
+        if (frame.sizes[1] == 0)
+        {
+            frameData[channel] = frame.data[0][channel];
+            continue;
+        }
+
+        float* gathered = m_readBuffer.getWritePointer(channel);
+        FloatVectorOperations::copy(gathered, frame.data[0][channel], frame.sizes[0]);
+        FloatVectorOperations::copy(gathered + frame.sizes[0], frame.data[1][channel], frame.sizes[1]);
+        frameData[channel] = gathered;
+    }
+}
+
+int SpectrumAnalyzer::getDecimationFactor(float maxFrequency) const
+{
+    // Keep the maximum frequency in the flat part of the anti-aliasing filter (60% of the decimated Nyquist frequency)
+    int factor = 1;
+    while (factor * 2 <= maxDecimationFactor && 0.6 * m_sampleRate / (2 * factor * 2) >= maxFrequency)
+    {
+        factor *= 2;
+    }
+
+    return factor;
+}
+
+void SpectrumAnalyzer::resetHistory()
+{
+    m_averager.reset(m_currentTransformMode == TransformMode::FFT ? m_plan->fftBins : m_frequencyAxis.getResolution());
+
+    for (auto& partialTracker : m_partialTrackers)
+        partialTracker.reset();
+
+    m_featureExtractor.reset();
+    m_levelRangeTracker.reset();
+
+    for (auto& watchedBank : m_watchedBanks)
+        watchedBank->reset();
+
+    m_watchedBanksFilled = false;
+}
+
+int SpectrumAnalyzer::watchFrequencies(const FrameRegions& frame, int fftSize, int hopSize)
+{
+    const int resolution = m_frequencyAxis.getResolution();
+    const int numChannels = m_currentChannelMode == ChannelMode::Dual ? 2 : 1;
+    const int numFrequencies = m_watchedBanks[0]->getNumFrequencies();
+
+    const float* frameData[maxChannels];
+    gatherFrame(frame, frameData);
+
+    // Only the samples of the new hop are fed to the sliding DFTs, which keep the previous ones.
+    // Empty DFTs get the older samples of the frame first, so they're full by the end of the hop.
+    const int numHistorySamples = m_watchedBanksFilled ? 0 : fftSize - hopSize;
+    const int numSamples = numHistorySamples + hopSize;
+    m_watchedBanksFilled = true;
+
+    const float* newData[maxChannels];
+    for (int channel = 0; channel < maxChannels; ++channel)
+        newData[channel] = frameData[channel] + fftSize - numSamples;
+
+    if (frame.premixed)
+        FloatVectorOperations::copy(m_mixedData, newData[0], numSamples);
+    else if (numChannels == 1)
+        mixChannels(newData, m_mixedData, nullptr, numSamples);
+
+    FloatVectorOperations::clear(m_visuData, numChannels * resolution);
+
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        const float* input = numChannels == 1 ? m_mixedData.getData() : newData[channel];
+        float magnitudes[SlidingDFTBank::maxFrequencies];
+
+        // The peaks of the column are only taken over the hop
+        if (numHistorySamples > 0)
+            m_watchedBanks[channel]->process(input, numHistorySamples, magnitudes);
+
+        m_watchedBanks[channel]->process(input + numHistorySamples, hopSize, magnitudes);
+
+        // Frequencies sharing the same position of the axis keep the loudest magnitude
+        float* output = m_visuData + channel * resolution;
+        for (int i = 0; i < numFrequencies; ++i)
+        {
+            if (m_watchedRows[i] >= 0)
+                output[m_watchedRows[i]] = jmax(output[m_watchedRows[i]], magnitudes[i]);
+        }
+    }
+
+    return numChannels;
+}
+
+void SpectrumAnalyzer::trackPartials(int channel, const float* averagedData, SpectralFrame& frame)
+{
+    auto& partials = frame.partials[static_cast<size_t>(channel)];
+    if (!m_currentPartialTracking)
+    {
+        partials.numTracks = 0;
+        return;
+    }
+
+    if (m_currentTransformMode == TransformMode::FFT)
+    {
+        // The peaks are refined on the evenly spaced bins. A parabola through dB levels is only exact for a Gaussian window,
+        // but it stays within a small fraction of a bin for the main lobe of the usual windows.
+        const int fftBins = m_plan->fftBins;
+        gainsToDecibels(averagedData, m_binLevels, fftBins);
+        FloatVectorOperations::add(m_binLevels, m_levelOffset, fftBins);
+        m_partialTrackers[channel].process(m_binLevels, m_binFrequencies, fftBins, partials);
+    }
+    else
+    {
+        // Every frequency of the axis has already been computed
+        const int offset = channel * m_frequencyAxis.getResolution();
+        m_partialTrackers[channel].process(frame.dbLevels.data() + offset, frame.frequencies.data() + offset, m_frequencyAxis.getResolution(), partials);
+    }
+
+    // The axis belongs to this thread and may be remapped before the frame is drawn
+    for (int track = 0; track < partials.numTracks; ++track)
+    {
+        partials.rows[track] = m_frequencyAxis.getClosestIndex(partials.frequencies[track]);
+    }
+}
+
+void SpectrumAnalyzer::extractFeatures(int channel, const float* averagedData, const SpectralFrame& frame, SpectralFeatures& features)
+{
+    if (m_currentTransformMode == TransformMode::FFT)
+    {
+        // The features are computed on the bins, before the levels get interpolated over the axis
+        m_featureExtractor.process(channel, averagedData, m_binFrequencies, m_plan->fftBins, features);
+    }
+    else
+    {
+        const int resolution = m_frequencyAxis.getResolution();
+        m_featureExtractor.process(channel, averagedData, frame.frequencies.data() + channel * resolution, resolution, features);
+    }
+}
+
+void SpectrumAnalyzer::mixChannels(const float* const* frameData, float* output, const float* window, int numSamples) const
+{
+    const float* left = frameData[0];
+    const float* right = frameData[1];
+
+    // A single channel only needs to be windowed (or copied)
+    if (m_currentChannelMode == ChannelMode::Left || m_currentChannelMode == ChannelMode::Right)
+    {
+        const float* input = m_currentChannelMode == ChannelMode::Left ? left : right;
+        if (window != nullptr)
+            FloatVectorOperations::multiply(output, input, window, numSamples);
+        else
+            FloatVectorOperations::copy(output, input, numSamples);
+
+        return;
+    }
+
+    // output = (leftGain * left + rightGain * right) * window
+    jassert(m_currentChannelMode != ChannelMode::Dual);
+    float gains[maxChannels];
+    getChannelGains(gains);
+    const float leftGain = gains[0];
+    const float rightGain = gains[1];
+
+    if (window != nullptr)
+    {
+        for (int i = 0; i < numSamples; ++i)
+            output[i] = (leftGain * left[i] + rightGain * right[i]) * window[i];
+    }
+    else
+    {
+        for (int i = 0; i < numSamples; ++i)
+            output[i] = leftGain * left[i] + rightGain * right[i];
+    }
+}
+
+void SpectrumAnalyzer::mixFrame(const FrameRegions& frame, float* output, const float* window) const
+{
+    // The window follows the frame across the regions
+    int offset = 0;
+    for (int region = 0; region < 2 && frame.sizes[region] > 0; ++region)
+    {
+        const float* regionWindow = window != nullptr ? window + offset : nullptr;
+        if (frame.premixed)
+        {
+            if (regionWindow != nullptr)
+                FloatVectorOperations::multiply(output + offset, frame.data[region][0], regionWindow, frame.sizes[region]);
+            else
+                FloatVectorOperations::copy(output + offset, frame.data[region][0], frame.sizes[region]);
+        }
+        else
+        {
+            mixChannels(frame.data[region], output + offset, regionWindow, frame.sizes[region]);
+        }
+
+        offset += frame.sizes[region];
+    }
+}
+
+void SpectrumAnalyzer::getChannelGains(float* gains) const noexcept
+{
+    gains[0] = 1.0f;
+    gains[1] = 1.0f;
+
+    switch (m_currentChannelMode)
+    {
+    case ChannelMode::Left:
+        gains[1] = 0.0f;
+        break;
+    case ChannelMode::Right:
+        gains[0] = 0.0f;
+        break;
+    case ChannelMode::Mid:
+        gains[0] = gains[1] = 0.5f;
+        break;
+    case ChannelMode::Side:
+        gains[0] = 0.5f;
+        gains[1] = -0.5f;
+        break;
+    default:
+        break;
+    }
+}
+
+void SpectrumAnalyzer::performRealTransform(const float* input, dsp::Complex<float>* spectrum, int fftSize)
+{
+    const int fftBins = fftSize >> 1;
+
+    // z[n] = x[2n] + i * x[2n + 1], which is exactly how the real frame is laid out in memory
+    auto* packedSpectrum = reinterpret_cast<dsp::Complex<float>*>(m_fftData.getData());
+    m_plan->halfFFT->perform(reinterpret_cast<const dsp::Complex<float>*>(input), packedSpectrum);
+
+    // Spectra of the even and odd samples: E[k] = (Z[k] + conj(Z[M - k])) / 2 and O[k] = (Z[k] - conj(Z[M - k])) / 2i,
+    // then X[k] = E[k] + e^(-2i * pi * k / N) * O[k]
+    const auto* twiddles = m_plan->twiddles.getData();
+    for (int k = 0; k < fftBins; ++k)
+    {
+        const auto z = packedSpectrum[k];
+        const auto zConjugate = std::conj(packedSpectrum[(fftBins - k) & (fftBins - 1)]);
+        const auto even = 0.5f * (z + zConjugate);
+        const auto odd = dsp::Complex<float>(0.0f, -0.5f) * (z - zConjugate);
+        spectrum[k] = even + twiddles[k] * odd;
+    }
+}
+
+const dsp::Complex<float>* SpectrumAnalyzer::computeSpectra(const FrameRegions& frame, const float* window, int fftSize)
+{
+    const int fftBins = fftSize >> 1;
+
+    if (m_currentChannelMode == ChannelMode::Dual)
+    {
+        // Both channels are analyzed with a single complex FFT
+        int offset = 0;
+        for (int region = 0; region < 2 && frame.sizes[region] > 0; ++region)
+        {
+            const float* regionWindow = window != nullptr ? window + offset : nullptr;
+            packChannels(frame.data[region][0], frame.data[region][1], regionWindow, regionWindow, frame.sizes[region], m_spectrumData + offset);
+            offset += frame.sizes[region];
+        }
+
+        transformPackedFrame(fftSize, m_spectrumData, m_spectrumData + fftBins);
+        return m_spectrumData;
+    }
+
+    // The mixed frame is written as packed complex values, so nothing has to be cleared
+    float* packedFrame = reinterpret_cast<float*>(m_spectrumData.getData());
+    mixFrame(frame, packedFrame, window);
+    performRealTransform(packedFrame, m_spectrumData, fftSize);
+    return m_spectrumData;
+}
+
+void SpectrumAnalyzer::performPackedTransform(const float* first, const float* second, const float* firstWindow, const float* secondWindow,
+                                              int fftSize, dsp::Complex<float>* firstSpectrum, dsp::Complex<float>* secondSpectrum)
+{
+    if (second == nullptr)
+    {
+        // A single real signal only needs the half-size transform
+        float* packedFrame = reinterpret_cast<float*>(m_spectrumData.getData());
+        if (firstWindow != nullptr)
+            FloatVectorOperations::multiply(packedFrame, first, firstWindow, fftSize);
+        else
+            FloatVectorOperations::copy(packedFrame, first, fftSize);
+
+        performRealTransform(packedFrame, firstSpectrum, fftSize);
+        return;
+    }
+
+    packChannels(first, second, firstWindow, secondWindow, fftSize, m_spectrumData);
+    transformPackedFrame(fftSize, firstSpectrum, secondSpectrum);
+}
+
+void SpectrumAnalyzer::packChannels(const float* first, const float* second, const float* firstWindow, const float* secondWindow,
+                                    int numSamples, dsp::Complex<float>* output) noexcept
+{
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const float firstValue = firstWindow != nullptr ? first[i] * firstWindow[i] : first[i];
+        const float secondValue = secondWindow != nullptr ? second[i] * secondWindow[i] : second[i];
+        output[i] = { firstValue, secondValue };
+    }
+}
+
+void SpectrumAnalyzer::transformPackedFrame(int fftSize, dsp::Complex<float>* firstSpectrum, dsp::Complex<float>* secondSpectrum)
+{
+    const int fftBins = fftSize >> 1;
+
+    auto* packedSpectrum = reinterpret_cast<dsp::Complex<float>*>(m_fftData.getData());
+    m_plan->forwardFFT->perform(m_spectrumData, packedSpectrum);
+
+    // A[k] = (Z[k] + conj(Z[N - k])) / 2 and B[k] = (Z[k] - conj(Z[N - k])) / 2i
+    for (int k = 0; k < fftBins; ++k)
+    {
+        const auto z = packedSpectrum[k];
+        const auto zConjugate = std::conj(packedSpectrum[(fftSize - k) & (fftSize - 1)]);
+        firstSpectrum[k] = 0.5f * (z + zConjugate);
+        secondSpectrum[k] = dsp::Complex<float>(0.0f, -0.5f) * (z - zConjugate);
+    }
+}
+
+int SpectrumAnalyzer::reassignFrame(const FrameRegions& frame, int fftSize, int hopSize)
+{
+    const int fftBins = fftSize >> 1;
+    const int resolution = m_frequencyAxis.getResolution();
+    const int numChannels = m_currentChannelMode == ChannelMode::Dual ? 2 : 1;
+
+    // One block of fftSize values for each window, channel after channel
+    auto* spectra = m_reassignmentSpectra.getData();
+    auto* derivativeSpectra = spectra + fftSize;
+    auto* timeWeightedSpectra = spectra + 2 * fftSize;
+
+    // The window and its derivative are packed in the same FFT (every input is real)
+    if (numChannels == 2)
+    {
+        // Each channel is transformed three times, so a wrapped frame is only gathered once
+        const float* frameData[maxChannels];
+        gatherFrame(frame, frameData);
+
+        performPackedTransform(frameData[0], frameData[0], m_window->window, m_window->derivativeWindow, fftSize, spectra, derivativeSpectra);
+        performPackedTransform(frameData[1], frameData[1], m_window->window, m_window->derivativeWindow, fftSize, spectra + fftBins, derivativeSpectra + fftBins);
+        performPackedTransform(frameData[0], frameData[1], m_window->timeWeightedWindow, m_window->timeWeightedWindow, fftSize, timeWeightedSpectra, timeWeightedSpectra + fftBins);
+    }
+    else
+    {
+        mixFrame(frame, m_mixedData, nullptr);
+        performPackedTransform(m_mixedData, m_mixedData, m_window->window, m_window->derivativeWindow, fftSize, spectra, derivativeSpectra);
+        performPackedTransform(m_mixedData, nullptr, m_window->timeWeightedWindow, nullptr, fftSize, timeWeightedSpectra, nullptr);
+    }
+
+    // Same normalization as the FFT mode, so that the levels don't depend on the FFT size
+    const float magnitudeScale = 1.0f / fftBins;
+    // Bins below -100 dB don't show up anyway, and their instantaneous frequency is mostly noise
+    const float minPower = square(fftBins * Decibels::decibelsToGain(-100.0f));
+    const float binToFreq = static_cast<float>(m_analysisRate) / fftSize;
+    const float radiansToBins = fftSize / MathConstants<float>::twoPi;
+    const float maxDelay = 0.5f * hopSize;
+
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        float* magnitudes = m_visuData + channel * resolution;
+        float* frequencies = m_reassignedFrequencies + channel * resolution;
+        FloatVectorOperations::clear(magnitudes, resolution);
+        for (int x = 0; x < resolution; ++x)
+        {
+            frequencies[x] = m_frequencyAxis[x];
+        }
+
+        const auto* spectrum = spectra + channel * fftBins;
+        const auto* derivativeSpectrum = derivativeSpectra + channel * fftBins;
+        const auto* timeWeightedSpectrum = timeWeightedSpectra + channel * fftBins;
+
+        for (int k = 1; k < fftBins; ++k)
+        {
+            const auto value = spectrum[k];
+            const float power = std::norm(value);
+            if (power < minPower)
+                continue;
+
+            // Group delay (in samples from the center of the frame): Re(X_th * conj(X_h)) / |X_h|^2
+            const float delay = (timeWeightedSpectrum[k] * std::conj(value)).real() / power;
+            if (std::abs(delay) > maxDelay)
+                continue;
+
+            // Instantaneous frequency (in radians per sample): w_k - Im(X_dh * conj(X_h)) / |X_h|^2
+            const float frequencyOffset = (derivativeSpectrum[k] * std::conj(value)).imag() / power;
+            const float frequency = (k - frequencyOffset * radiansToBins) * binToFreq;
+
+            const int x = m_frequencyAxis.getClosestIndex(frequency);
+            const float magnitude = std::sqrt(power) * magnitudeScale;
+            if (x >= 0 && magnitude > magnitudes[x])
+            {
+                magnitudes[x] = magnitude;
+                frequencies[x] = frequency;
+            }
+        }
+    }
+
+    return numChannels;
+}
+
+int SpectrumAnalyzer::transformFrame(const FrameRegions& frame, int fftSize)
+{
+    const int fftBins = fftSize >> 1;
+    const int numChannels = m_currentChannelMode == ChannelMode::Dual ? 2 : 1;
+
+    const auto* spectra = computeSpectra(frame, m_window->window, fftSize);
+    for (int k = 0; k < numChannels * fftBins; ++k)
+    {
+        m_fftData[k] = std::abs(spectra[k]);
+    }
+
+    return numChannels;
+}
+
+void SpectrumAnalyzer::updateWindow()
+{
+    m_window = m_plan->windows[static_cast<int>(m_currentWindowType)].get();
+
+    const float kaiserBeta = m_kaiserBeta;
+    if (m_currentWindowType == WindowType::Kaiser && m_window->beta != kaiserBeta)
+    {
+        m_window->fill(WindowType::Kaiser, kaiserBeta);
+    }
+
+    // The constant-Q kernels and the sliding DFTs have their own window
+    if (m_currentTransformMode == TransformMode::ConstantQ || m_currentTransformMode == TransformMode::Watched)
+    {
+        m_levelOffset = 0.0f;
+        return;
+    }
+
+    // A sine reads its amplitude once the coherent gain is removed, and noise reads its level in a 1-bin bandwidth once the ENBW is removed
+    m_levelOffset = -Decibels::gainToDecibels(m_window->coherentGain);
+    if (m_noiseLevelCorrection)
+    {
+        m_levelOffset -= 10.0f * std::log10(m_window->noiseBandwidth);
+    }
+}
+
+void SpectrumAnalyzer::mapLevels(int channel, const float* inputData, Range<float> levelRange, float* dbLevels, float* normalizedLevels)
+{
+    const int resolution = m_frequencyAxis.getResolution();
+    const bool adaptativeLevel = m_adaptativeLevel;
+    const bool clipLevel = m_clipLevel;
+
+    // Silent frame (the tracked range isn't updated, so it's still valid once the signal is back)
+    if (levelRange.getEnd() == 0.0f)
+    {
+        FloatVectorOperations::clear(dbLevels, resolution);
+        FloatVectorOperations::clear(normalizedLevels, resolution);
+        return;
+    }
+
+    // Convert the whole column at once
+    gainsToDecibels(inputData, dbLevels, resolution, LevelRangeTracker::minLevel);
+    FloatVectorOperations::add(dbLevels, m_levelOffset, resolution);
+    if (!adaptativeLevel && clipLevel)
+    {
+        FloatVectorOperations::min(dbLevels, dbLevels, 0.0f, resolution);
+    }
+
+    // The tracked range is always at least LevelRangeTracker::minRange wide
+    const auto dbRange = adaptativeLevel ? m_levelRangeTracker.process(channel, dbLevels, resolution) : Range<float>(-90.0f, 10.0f);
+    const float mindB = dbRange.getStart();
+    const float maxdB = dbRange.getEnd();
+
+    // Map the levels between 0 and 1
+    FloatVectorOperations::clip(normalizedLevels, dbLevels, mindB, maxdB, resolution);
+    FloatVectorOperations::add(normalizedLevels, -mindB, resolution);
+    FloatVectorOperations::multiply(normalizedLevels, 1.0f / (maxdB - mindB), resolution);
+}
+
+void SpectrumAnalyzer::updateFrequencyMapping()
+{
+    const int fftBins = m_plan->fftBins;
+
+    // Bin k of an FFT of fftSize samples is centered on k * sampleRate / fftSize
+    const float binWidth = static_cast<float>(m_analysisRate / m_plan->fftSize);
+    const float freqToBin = 1.0f / binWidth;
+    for (int bin = 0; bin < fftBins; ++bin)
+    {
+        m_binFrequencies[bin] = bin * binWidth;
+    }
+
+    if (m_currentTransformMode == TransformMode::ConstantQ)
+    {
+        m_constantQKernel.build(m_frequencyAxis, m_plan->fftSize, m_analysisRate);
+        return;
+    }
+
+    // Reassigned bins are looked up on the axis directly
+    if (m_currentTransformMode == TransformMode::Reassigned)
+        return;
+
+    if (m_currentTransformMode == TransformMode::Watched)
+    {
+        // The DFTs are as long as the FFT frames, so both modes have the same resolution
+        float frequencies[SlidingDFTBank::maxFrequencies];
+        const int numFrequencies = m_numWatchedFrequencies;
+        for (int i = 0; i < numFrequencies; ++i)
+            frequencies[i] = m_watchedFrequencies[i];
+
+        for (auto& watchedBank : m_watchedBanks)
+            watchedBank->setFrequencies(frequencies, numFrequencies, m_plan->fftSize, m_analysisRate);
+
+        m_watchedBanksFilled = false;
+
+        for (int i = 0; i < m_watchedBanks[0]->getNumFrequencies(); ++i)
+            m_watchedRows[i] = m_frequencyAxis.getClosestIndex(m_watchedBanks[0]->getFrequency(i));
+
+        m_currentWatchedVersion = m_watchedVersion;
+        return;
+    }
+
+    // Perceptual axes sum the bins with overlapping triangles, like the usual mel filterbanks
+    if (m_frequencyAxis.isPerceptual())
+    {
+        m_filterbank.build(m_frequencyAxis, fftBins, m_analysisRate);
+        return;
+    }
+
+    // 1- Lower frequencies are interpolated
+    m_interpolationMatrix.build(m_frequencyAxis, fftBins, m_analysisRate, InterpolationMatrix::Mode::Lanczos);
+
+    // 2- Higher frequencies keep the loudest of the bins mapped to them
+    m_binRanges.clear();
+    int x = m_interpolationMatrix.getNumRows();
+    int lastBin = static_cast<int>(m_frequencyAxis[x] * freqToBin);
+    for (; x < m_frequencyAxis.getResolution(); ++x)
+    {
+        const int currentBin = static_cast<int>(m_frequencyAxis[x] * freqToBin);
+
+        // Bins between the last coordinate (excluded) and this one. If none, the current bin is used.
+        const int firstBin = lastBin < currentBin ? lastBin + 1 : currentBin;
+        m_binRanges.emplace_back(firstBin, currentBin + 1);
+        lastBin = currentBin;
+    }
+}
+
+void SpectrumAnalyzer::interpolateData(const float* inputData, float* outputData, float* frequencies)
+{
+    if (m_frequencyAxis.isPerceptual())
+    {
+        // Every frequency of the axis has its own filter
+        m_filterbank.apply(inputData, outputData);
+        for (int x = 0; x < m_filterbank.getNumRows(); ++x)
+        {
+            frequencies[x] = m_frequencyAxis[x];
+        }
+
+        return;
+    }
+
+    const int numRows = m_interpolationMatrix.getNumRows();
+    const float binToFreq = static_cast<float>(m_analysisRate / m_plan->fftSize);
+
+    // 1- Interpolate lower frequencies
+    m_interpolationMatrix.apply(inputData, outputData);
+    for (int x = 0; x < numRows; ++x)
+    {
+        frequencies[x] = m_frequencyAxis[x];
+    }
+
+    // 2- Filter out higher frequencies
+    for (size_t i = 0; i < m_binRanges.size(); ++i)
+    {
+        // Select the bin with the highest level for display
+        const auto& binRange = m_binRanges[i];
+        const int maxBin = binRange.getStart() + findMaxIndex(inputData + binRange.getStart(), binRange.getLength());
+
+        outputData[numRows + i] = inputData[maxBin];
+        frequencies[numRows + i] = maxBin * binToFreq;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,649 @@
+//--------------------------------------------------------------------------------------------
+// Name: SpectrumAnalyzer.h
+// Author: Jérémi Panneton
+// Creation date: October 16th, 2026
+//--------------------------------------------------------------------------------------------
+
+#pragma once
+
+#include "JuceHeader.h"
+#include "ConstantQKernel.h"
+#include "Decimator.h"
+#include "FFTBackend.h"
+#include "InterpolationMatrix.h"
+#include "TriangularFilterbank.h"
+#include "PartialTracker.h"
+#include "SpectralAverager.h"
+#include "SpectralFeatures.h"
+#include "SlidingDFTBank.h"
+#include "LevelRangeTracker.h"
+#include "Utilities/FrameQueue.h"
+#include "Utilities/FrequencyAxis.h"
+#include "Utilities/HistoryBuffer.h"
+#include "Utilities/RingBuffer.h"
+#include <atomic>
+#include <memory>
+#include <vector>
+
+//--------------------------------------------------------------------------------------------
+/// Finished spectral column produced by the analysis thread (one level for each frequency of the axis).
+/// When more than one channel is analyzed, the columns are stored one after the other.
+//--------------------------------------------------------------------------------------------
+struct SpectralFrame
+{
+    //----------------------------------------------------------------------------------------
+    /// Constructor.
+    /// @param[in] resolution				Number of frequencies contained in the frequency axis.
+    /// @param[in] maxChannels				Maximum number of channels (columns) the frame can hold.
+    //----------------------------------------------------------------------------------------
+    SpectralFrame(int resolution = 0, int maxChannels = 1)
+        : dbLevels(static_cast<size_t>(resolution * maxChannels))
+        , normalizedLevels(static_cast<size_t>(resolution * maxChannels))
+        , frequencies(static_cast<size_t>(resolution * maxChannels))
+        , partials(static_cast<size_t>(maxChannels))
+    {
+    }
+
+    int numChannels = 1;					/// Number of channels (columns) contained in the frame.
+    std::vector<float> dbLevels;			/// Level in dB of each frequency (channel after channel).
+    std::vector<float> normalizedLevels;	/// Normalized level (between 0 and 1) of each frequency (channel after channel). Should be used for display.
+    std::vector<float> frequencies;			/// Frequency of each level (channel after channel). Matches the frequency axis, except for the higher frequencies which hold the frequency of their loudest bin.
+    std::vector<PartialTracks> partials;	/// Partials tracked in each channel (empty if partial tracking is off).
+    int64 startSample = 0;					/// Position in the ring buffer's stream of the first sample of the analyzed audio (original rate).
+    int64 endSample = 0;					/// Position in the ring buffer's stream right after the last sample of the analyzed audio (0 until analyzed).
+};
+
+//--------------------------------------------------------------------------------------------
+/// Short-time Fourier analysis running on a dedicated thread.
+/// Every available hop in the ring buffer is turned into a spectral frame, which is averaged, interpolated
+/// over the frequency axis and mapped to levels. Finished frames are published through a lock-free queue,
+/// so the rendering thread only has to upload and draw them.
+/// When the maximum frequency is low enough, the signal is decimated before the FFT (zoom FFT), so the
+/// bins are concentrated on the displayed range.
+//--------------------------------------------------------------------------------------------
+class SpectrumAnalyzer : private Thread
+{
+public:
+    enum
+    {
+        minFftOrder = 8, // 256 samples
+        maxFftOrder = 15, // 32768 samples
+        defaultFftOrder = 12, // 4096 samples
+        maxFftSize = 1 << maxFftOrder, // 2 ^ maxFftOrder
+        defaultHopSize = 1024,
+        frameQueueSize = 64,
+        maxChannels = 2,
+        maxDecimationFactor = 64,
+        numWindowTypes = 4,
+        defaultMaxPendingFrames = 8,
+        featureHistorySize = 1024
+    };
+
+    static constexpr float defaultKaiserBeta = 9.0f; // Side lobes around -66 dB
+    static constexpr double defaultTimeBudget = 10.0; // ms
+
+    //----------------------------------------------------------------------------------------
+    /// Defines which signal is analyzed.
+    //----------------------------------------------------------------------------------------
+    enum class ChannelMode
+    {
+        Left,	/// Left channel only.
+        Right,	/// Right channel only.
+        Sum,	/// Sum of both channels (L + R).
+        Mid,	/// Mid signal ((L + R) / 2).
+        Side,	/// Side signal ((L - R) / 2).
+        Dual	/// Left and right channels analyzed separately (two columns per frame).
+    };
+
+    //----------------------------------------------------------------------------------------
+    /// Defines how the spectrum is mapped to the frequency axis.
+    /// The watched mode costs O(hop size * frequencies * 3) per frame and channel (three Hann resonators per frequency),
+    /// regardless of the FFT size.
+    //----------------------------------------------------------------------------------------
+    enum class TransformMode
+    {
+        FFT,		/// Single FFT resolution, interpolated (lower frequencies) and max pooled (higher frequencies) over the axis.
+        ConstantQ,	/// Constant-Q transform: each frequency of the axis is computed once, with a window length matching the axis spacing.
+        Reassigned,	/// Reassigned FFT: the magnitude of each bin is moved to its instantaneous frequency, and kept only if its group delay falls within the current hop.
+        Watched		/// Only the watched frequencies are analyzed, sample by sample, by a bank of sliding DFTs (no FFT). The other frequencies of the axis stay silent.
+    };
+
+    //----------------------------------------------------------------------------------------
+    /// Defines the window applied to the frames before the FFT.
+    //----------------------------------------------------------------------------------------
+    enum class WindowType
+    {
+        Hann,			/// Good compromise between frequency resolution and leakage.
+        BlackmanHarris,	/// Very low side lobes (-92 dB), for measurements down to a low noise floor.
+        FlatTop,		/// Flat main lobe, so that the level of a sine doesn't depend on its position between two bins.
+        Kaiser			/// Trade-off between main lobe width and side lobe level set by the beta parameter.
+    };
+
+    //----------------------------------------------------------------------------------------
+    /// Defines what happens to the backlog of audio data when the analysis falls behind.
+    //----------------------------------------------------------------------------------------
+    enum class LatencyPolicy
+    {
+        ProcessAll,		/// Every hop is analyzed. The display lags behind until the backlog is processed (audio data is dropped once the ring buffer is full).
+        NewestFrames,	/// Only the newest hops are analyzed, and the older audio data is skipped, so the display never lags by more than that many hops.
+        TimeBudget		/// Hops are analyzed until the time budget of the batch runs out, then the older audio data is skipped.
+    };
+
+    //----------------------------------------------------------------------------------------
+    /// Spectral features of every analyzed channel of a frame, as stored in the feature history.
+    //----------------------------------------------------------------------------------------
+    struct FeatureSnapshot
+    {
+        int numChannels = 0;								/// Number of analyzed channels.
+        SpectralFeatures channels[maxChannels];				/// Features of each analyzed channel.
+    };
+
+    //----------------------------------------------------------------------------------------
+    /// Constructor.
+    /// @param[in] ringBuffer				Ring buffer that holds the incoming audio data.
+    /// @param[in] ringReader				Index of the analyzer's reader in the ring buffer (the analysis thread is its only user).
+    /// @param[in] readBuffer				Temporary buffer used to store the current audio frame. Its size should be at least maxFftSize.
+    /// @param[in] sampleRate				Sample rate.
+    /// @param[in] outputResolution			Frequency output resolution.
+    /// @param[in] fftBackend				Implementation of the transforms. Fastest picks the fastest backend for each FFT order (measured once per process).
+    //----------------------------------------------------------------------------------------
+    SpectrumAnalyzer(StereoRingBuffer& ringBuffer, int ringReader, AudioBuffer<float>& readBuffer, double sampleRate, int outputResolution,
+                     FFTBackend::Type fftBackend = FFTBackend::Type::Fastest);
+
+    //----------------------------------------------------------------------------------------
+    /// Destructor. Stops the analysis thread.
+    //----------------------------------------------------------------------------------------
+    ~SpectrumAnalyzer();
+
+    //----------------------------------------------------------------------------------------
+    /// Starts the analysis thread. Pending frames are discarded.
+    //----------------------------------------------------------------------------------------
+    void start();
+
+    //----------------------------------------------------------------------------------------
+    /// Stops the analysis thread (blocking).
+    //----------------------------------------------------------------------------------------
+    void stop();
+
+    //----------------------------------------------------------------------------------------
+    /// Sets the maximum frequency of the frequency axis. The axis is remapped by the analysis thread before the next frame.
+    /// If the frequency is low enough, the signal gets decimated so that the whole FFT covers the displayed range.
+    /// @param[in] frequency				Maximum frequency.
+    //----------------------------------------------------------------------------------------
+    void setMaxFrequency(float frequency);
+
+    //----------------------------------------------------------------------------------------
+    /// Sets how the frequencies are distributed over the axis. The axis is remapped by the analysis thread before the next frame.
+    /// In FFT mode, the perceptual distributions (mel, Bark, ERB) sum the bins with a triangular filterbank instead of
+    /// interpolating them.
+    /// @param[in] distribution				Frequency distribution.
+    //----------------------------------------------------------------------------------------
+    void setFrequencyDistribution(FrequencyAxis<float>::Distribution distribution);
+
+    //----------------------------------------------------------------------------------------
+    /// Sets the adaptive level mode on or off.
+    /// @param[in] enabled					If true, the level is normalized using min et max levels. If false, the original level is used for visualization.
+    //----------------------------------------------------------------------------------------
+    void setAdaptiveLevel(bool enabled);
+
+    //----------------------------------------------------------------------------------------
+    /// Sets the clip level mode on or off.
+    /// @param[in] enabled					If true, the level is clipped to 0 dB. If false, the level is clipped to an arbitrary positive dB value.
+    //----------------------------------------------------------------------------------------
+    void setClipLevel(bool enabled);
+
+    //----------------------------------------------------------------------------------------
+    /// Sets the hop size of the STFT (distance between two consecutive analysis frames).
+    /// The hop size doesn't depend on the FFT size, so the time resolution of the display stays the same when switching sizes.
+    /// @param[in] hopSize					Hop size in samples (at the original sample rate). Gets clipped between fftSize / 16 and fftSize analyzed samples when used.
+    //----------------------------------------------------------------------------------------
+    void setHopSize(int hopSize);
+
+    //----------------------------------------------------------------------------------------
+    /// Sets the size of the FFT. The according plan is preallocated, so the switch performed by the analysis thread never allocates.
+    /// @param[in] order					FFT order (size = 2 ^ order). Gets clipped between minFftOrder and maxFftOrder.
+    //----------------------------------------------------------------------------------------
+    void setFftOrder(int order);
+
+    //----------------------------------------------------------------------------------------
+    /// Sets which signal is analyzed. The averaged output is reset by the analysis thread when the mode changes.
+    /// @param[in] mode						Channel mode.
+    //----------------------------------------------------------------------------------------
+    void setChannelMode(ChannelMode mode);
+
+    //----------------------------------------------------------------------------------------
+    /// Sets how the spectrum is mapped to the frequency axis. The averaged output is reset by the analysis thread when the mode changes.
+    /// In constant-Q mode, the FFT size bounds the window length of the lowest frequencies.
+    /// In reassigned mode, each frame costs two more FFTs (derivative and time-weighted windows).
+    /// In watched mode, the FFT size sets the length (and so the resolution) of the sliding DFTs.
+    /// @param[in] mode						Transform mode.
+    //----------------------------------------------------------------------------------------
+    void setTransformMode(TransformMode mode);
+
+    //----------------------------------------------------------------------------------------
+    /// Sets the frequencies analyzed in watched mode (mains hum and its harmonics by default).
+    /// @param[in] frequencies				Watched frequencies (in Hz).
+    /// @param[in] numFrequencies			Number of watched frequencies (at most SlidingDFTBank::maxFrequencies).
+    //----------------------------------------------------------------------------------------
+    void setWatchedFrequencies(const float* frequencies, int numFrequencies);
+
+    //----------------------------------------------------------------------------------------
+    /// Sets how consecutive spectral frames are averaged over time. Applied by the analysis thread before the next frame.
+    /// @param[in] settings					Averaging parameters.
+    //----------------------------------------------------------------------------------------
+    void setAveraging(const SpectralAverager::Settings& settings);
+
+    //----------------------------------------------------------------------------------------
+    /// Sets the window applied to the frames before the FFT. Every table is precomputed for every FFT size,
+    /// so the switch performed by the analysis thread never allocates (a new Kaiser beta only refills the current table).
+    /// The levels are corrected by the coherent gain of the window, so a sine reads the same level with every window.
+    /// @param[in] type						Window type.
+    /// @param[in] kaiserBeta				Beta parameter of the Kaiser window (larger values give lower side lobes and a wider main lobe).
+    //----------------------------------------------------------------------------------------
+    void setWindow(WindowType type, float kaiserBeta = defaultKaiserBeta);
+
+    //----------------------------------------------------------------------------------------
+    /// Sets the noise level correction on or off.
+    /// @param[in] enabled					If true, the levels are also corrected by the equivalent noise bandwidth of the window, so that
+    ///										the noise floor reads the same level with every window. If false, only the coherent gain is corrected.
+    //----------------------------------------------------------------------------------------
+    void setNoiseLevelCorrection(bool enabled);
+
+    //----------------------------------------------------------------------------------------
+    /// Sets how the analysis catches up when it falls behind. Pending hops are processed in batches (one per wake up of the
+    /// analysis thread), back to back with the same plan, and the policy decides which of them are skipped.
+    /// @param[in] policy					Latency policy.
+    /// @param[in] maxFrames				Maximum number of pending hops processed by a batch (NewestFrames policy).
+    /// @param[in] timeBudget				Maximum duration of a batch in milliseconds (TimeBudget policy). The frame in progress is always finished.
+    //----------------------------------------------------------------------------------------
+    void setLatencyPolicy(LatencyPolicy policy, int maxFrames = defaultMaxPendingFrames, double timeBudget = defaultTimeBudget);
+
+    //----------------------------------------------------------------------------------------
+    /// Sets the partial tracking on or off. The tracks start over when it's turned on.
+    /// @param[in] enabled					If true, the peaks of the averaged frames are linked into partial tracks. If false, the frames hold no partial.
+    //----------------------------------------------------------------------------------------
+    void setPartialTracking(bool enabled);
+
+    //----------------------------------------------------------------------------------------
+    /// Returns the requested size of the FFT.
+    //----------------------------------------------------------------------------------------
+    int getFftSize() const noexcept;
+
+    //----------------------------------------------------------------------------------------
+    /// Returns the names of the FFT implementations used with the requested FFT size: the full size transform,
+    /// then the half size one used for real frames. The plans never change once built, so any thread can call it.
+    //----------------------------------------------------------------------------------------
+    String getFftBackendNames() const;
+
+    //----------------------------------------------------------------------------------------
+    /// Returns the number of frequencies of the axis (levels of a channel in a spectral frame).
+    /// It's fixed at construction, unlike the frequencies themselves which only the analysis thread may read.
+    //----------------------------------------------------------------------------------------
+    int getResolution() const noexcept;
+
+    //----------------------------------------------------------------------------------------
+    /// Returns the spectral features of the latest frames (computed on the averaged spectra).
+    /// The history is lock-free and reading it doesn't consume anything, so any thread (GUI, host) can read it at any time.
+    //----------------------------------------------------------------------------------------
+    const HistoryBuffer<FeatureSnapshot>& getFeatureHistory() const noexcept;
+
+    //----------------------------------------------------------------------------------------
+    /// Pops the oldest finished spectral frame. Should only be called from a single consumer thread.
+    /// @param[out] frame					Frame in which to copy the spectral data. Its resolution should match the frequency axis.
+    /// @return								False if no frame is available. True otherwise.
+    //----------------------------------------------------------------------------------------
+    bool popFrame(SpectralFrame& frame);
+
+private:
+    //----------------------------------------------------------------------------------------
+    /// Window of a given type and size, along with the tables derived from it.
+    //----------------------------------------------------------------------------------------
+    struct WindowTables
+    {
+        //------------------------------------------------------------------------------------
+        /// Constructor. The tables are allocated, but left empty.
+        /// @param[in] fftSize				Number of samples in a frame.
+        //------------------------------------------------------------------------------------
+        WindowTables(int fftSize);
+
+        //------------------------------------------------------------------------------------
+        /// Fills the tables and computes the window properties. Never allocates.
+        /// @param[in] type					Window type.
+        /// @param[in] beta					Beta parameter (Kaiser window only).
+        //------------------------------------------------------------------------------------
+        void fill(WindowType type, float beta);
+
+        const int size;							/// Number of samples in the window.
+        HeapBlock<float> window;				/// Window table used to smooth spectral leakage (not normalized).
+        HeapBlock<float> derivativeWindow;		/// Derivative of the window, per sample (frequency reassignment).
+        HeapBlock<float> timeWeightedWindow;	/// Window multiplied by the time from its center, in samples (time reassignment).
+        float coherentGain = 1.0f;				/// Mean of the window, which is the gain applied to a sine.
+        float noiseBandwidth = 1.0f;			/// Equivalent noise bandwidth of the window, in bins.
+        float beta = 0.0f;						/// Beta parameter the table was filled with (Kaiser window only).
+    };
+
+    //----------------------------------------------------------------------------------------
+    /// Holds everything needed to analyze a frame of a given size.
+    /// One plan is preallocated for each supported FFT order.
+    //----------------------------------------------------------------------------------------
+    struct FFTPlan
+    {
+        //------------------------------------------------------------------------------------
+        /// Constructor.
+        /// @param[in] order				FFT order (size = 2 ^ order).
+        /// @param[in] backend				Implementation of the transforms.
+        //------------------------------------------------------------------------------------
+        FFTPlan(int order, FFTBackend::Type backend);
+
+        const int fftOrder;						/// FFT order.
+        const int fftSize;						/// Number of samples in a frame (2 ^ fftOrder).
+        const int fftBins;						/// Number of frequency bins (fftSize / 2).
+        std::unique_ptr<FFTBackend> forwardFFT;	/// Forward Fourier transform function.
+        std::unique_ptr<FFTBackend> halfFFT;	/// Complex transform of half the size, used for real frames (even and odd samples packed as complex values).
+        HeapBlock<dsp::Complex<float>> twiddles; /// e^(-2i * pi * k / fftSize) for each bin, used to unpack the half-size transform.
+        std::vector<std::unique_ptr<WindowTables>> windows; /// Tables of each window type.
+    };
+
+    //----------------------------------------------------------------------------------------
+    /// Audio frame read in place: the samples of each channel lie in one or two contiguous regions,
+    /// since a frame of the ring buffer may wrap around (the second region continues the first one, and may be empty).
+    //----------------------------------------------------------------------------------------
+    struct FrameRegions
+    {
+        const float* data[2][maxChannels];	/// Start of each region, for each channel.
+        int sizes[2];						/// Number of samples in each region.
+        bool premixed = false;				/// True if the first channel already holds the mix of the channel mode (single channel modes only).
+    };
+
+    //----------------------------------------------------------------------------------------
+    /// @see Thread::run.
+    //----------------------------------------------------------------------------------------
+    void run() override;
+
+    //----------------------------------------------------------------------------------------
+    /// Applies the parameters changed since the last frame.
+    //----------------------------------------------------------------------------------------
+    void applyParameters();
+
+    //----------------------------------------------------------------------------------------
+    /// Turns the hops pending in the ring buffer into spectral frames, following the latency policy.
+    /// The parameters are applied once, so every frame of the batch shares the same plan (twiddles and window tables stay in cache).
+    /// @return								Number of published frames.
+    //----------------------------------------------------------------------------------------
+    int processPendingFrames();
+
+    //----------------------------------------------------------------------------------------
+    /// Reads the next hop from the ring buffer and publishes the according spectral frame.
+    /// Without decimation, the frame is analyzed in place in the ring buffer, and the hop is only removed once it's done.
+    /// @param[in] fftSize					Size of the FFT.
+    /// @param[in] hopSize					Number of (decimated) samples between two frames.
+    /// @return								False if there is not enough audio data or if the frame queue is full. True otherwise.
+    //----------------------------------------------------------------------------------------
+    bool processNextFrame(int fftSize, int hopSize);
+
+    //----------------------------------------------------------------------------------------
+    /// Reads the next hop from the ring buffer and appends its decimated samples to m_decimatedData.
+    /// The single channel modes derive their mix while reading, so only the first channel gets decimated.
+    /// @param[in] fftSize					Size of the FFT.
+    /// @param[in] hopSize					Number of decimated samples to append.
+    /// @param[out] endSample				Position in the stream following the last sample of the hop (set on success only).
+    /// @return								False if there is not enough audio data. True otherwise.
+    //----------------------------------------------------------------------------------------
+    bool readDecimatedHop(int fftSize, int hopSize, int64& endSample);
+
+    //----------------------------------------------------------------------------------------
+    /// Gives contiguous access to a frame, for the stages that can't handle its regions separately.
+    /// A wrapped frame is copied into m_readBuffer, an unwrapped one is used as is.
+    /// @param[in] frame					Audio frame.
+    /// @param[out] frameData				Start of the frame (fftSize samples) for each channel.
+    //----------------------------------------------------------------------------------------
+    void gatherFrame(const FrameRegions& frame, const float** frameData);
+
+    //----------------------------------------------------------------------------------------
+    /// Returns the largest decimation factor that keeps the specified frequency below the decimated Nyquist frequency
+    /// (with some room for the anti-aliasing filter).
+    /// @param[in] maxFrequency				Maximum frequency to analyze.
+    /// @return								Decimation factor (power of 2 between 1 and maxDecimationFactor).
+    //----------------------------------------------------------------------------------------
+    int getDecimationFactor(float maxFrequency) const;
+
+    //----------------------------------------------------------------------------------------
+    /// Clears everything that depends on the previous frames (averaged output and partial tracks).
+    /// The number of averaged values depends on the transform mode.
+    //----------------------------------------------------------------------------------------
+    void resetHistory();
+
+    //----------------------------------------------------------------------------------------
+    /// Updates the partial tracks of a channel with its averaged data.
+    /// @param[in] channel					Analyzed channel.
+    /// @param[in] averagedData				Averaged magnitudes (FFT bins, or frequencies of the axis depending on the transform mode).
+    /// @param[in,out] frame				Spectral frame being published. Its levels and frequencies should already be computed.
+    ///										The row of each track is mapped here, with the axis the frame was analyzed with.
+    //----------------------------------------------------------------------------------------
+    void trackPartials(int channel, const float* averagedData, SpectralFrame& frame);
+
+    //----------------------------------------------------------------------------------------
+    /// Computes the spectral features of a channel with its averaged data.
+    /// @param[in] channel					Analyzed channel.
+    /// @param[in] averagedData				Averaged magnitudes (FFT bins, or frequencies of the axis depending on the transform mode).
+    /// @param[in] frame					Spectral frame being published. Its frequencies should already be computed.
+    /// @param[out] features				Computed features.
+    //----------------------------------------------------------------------------------------
+    void extractFeatures(int channel, const float* averagedData, const SpectralFrame& frame, SpectralFeatures& features);
+
+    //----------------------------------------------------------------------------------------
+    /// Mixes and windows a contiguous part of the channels according to the channel mode (single channel modes only).
+    /// Everything is done in a single pass over the input.
+    /// @param[in] frameData				Audio data (one buffer of numSamples samples for each channel).
+    /// @param[out] output					Mixed channel (numSamples samples).
+    /// @param[in] window					Part of the window to apply, or nullptr to leave the data unwindowed.
+    /// @param[in] numSamples				Number of samples to mix.
+    //----------------------------------------------------------------------------------------
+    void mixChannels(const float* const* frameData, float* output, const float* window, int numSamples) const;
+
+    //----------------------------------------------------------------------------------------
+    /// Mixes and windows every region of the current audio frame, straight from where it's stored (single channel modes only).
+    /// @param[in] frame					Audio frame.
+    /// @param[out] output					Mixed channel (fftSize samples).
+    /// @param[in] window					Window to apply, or nullptr to leave the frame unwindowed.
+    //----------------------------------------------------------------------------------------
+    void mixFrame(const FrameRegions& frame, float* output, const float* window) const;
+
+    //----------------------------------------------------------------------------------------
+    /// Returns the gain of each channel in the mix of the current channel mode (both gains are 1 in the dual mode).
+    /// @param[out] gains					Gain of each channel (maxChannels values).
+    //----------------------------------------------------------------------------------------
+    void getChannelGains(float* gains) const noexcept;
+
+    //----------------------------------------------------------------------------------------
+    /// Computes the spectrum of a real frame with a complex transform of half the size.
+    /// The frame is seen as fftBins complex values (even samples as real parts, odd samples as imaginary parts),
+    /// whose spectrum is unpacked into the one of the real frame.
+    /// @param[in] input					Real frame (fftSize samples).
+    /// @param[out] spectrum				Positive frequencies of the frame (fftBins values). Can be the same buffer as input.
+    /// @param[in] fftSize					Size of the FFT.
+    //----------------------------------------------------------------------------------------
+    void performRealTransform(const float* input, dsp::Complex<float>* spectrum, int fftSize);
+
+    //----------------------------------------------------------------------------------------
+    /// Computes the complex spectrum of each analyzed channel (positive frequencies only), phase included.
+    /// The frame regions are mixed (or packed) and windowed on the fly, so the audio is only read once.
+    /// @param[in] frame					Audio frame.
+    /// @param[in] window					Window to apply, or nullptr to leave the frame unwindowed.
+    /// @param[in] fftSize					Size of the FFT.
+    /// @return								Spectra of the analyzed channels, one after the other (fftBins values each). Stored in m_spectrumData.
+    //----------------------------------------------------------------------------------------
+    const dsp::Complex<float>* computeSpectra(const FrameRegions& frame, const float* window, int fftSize);
+
+    //----------------------------------------------------------------------------------------
+    /// Computes the spectra of two windowed real signals with a single complex FFT: z[n] = a[n] * wa[n] + i * b[n] * wb[n].
+    /// Since both signals are real, their spectra are recovered from the symmetry of Z.
+    /// @param[in] first					First signal (fftSize samples).
+    /// @param[in] second					Second signal (fftSize samples), or nullptr to transform the first one only.
+    /// @param[in] firstWindow				Window applied to the first signal, or nullptr to leave it unwindowed.
+    /// @param[in] secondWindow				Window applied to the second signal, or nullptr to leave it unwindowed.
+    /// @param[in] fftSize					Size of the FFT.
+    /// @param[out] firstSpectrum			Positive frequencies of the first signal (fftBins values).
+    /// @param[out] secondSpectrum			Positive frequencies of the second signal (fftBins values). Unused if second is nullptr.
+    //----------------------------------------------------------------------------------------
+    void performPackedTransform(const float* first, const float* second, const float* firstWindow, const float* secondWindow,
+                                int fftSize, dsp::Complex<float>* firstSpectrum, dsp::Complex<float>* secondSpectrum);
+
+    //----------------------------------------------------------------------------------------
+    /// Packs a contiguous part of two windowed real signals as complex values: z[n] = a[n] * wa[n] + i * b[n] * wb[n].
+    /// @param[in] first					First signal (numSamples samples).
+    /// @param[in] second					Second signal (numSamples samples).
+    /// @param[in] firstWindow				Part of the window applied to the first signal, or nullptr to leave it unwindowed.
+    /// @param[in] secondWindow				Part of the window applied to the second signal, or nullptr to leave it unwindowed.
+    /// @param[in] numSamples				Number of samples to pack.
+    /// @param[out] output					Packed values (numSamples values).
+    //----------------------------------------------------------------------------------------
+    static void packChannels(const float* first, const float* second, const float* firstWindow, const float* secondWindow,
+                             int numSamples, dsp::Complex<float>* output) noexcept;
+
+    //----------------------------------------------------------------------------------------
+    /// Performs the complex FFT of the signals packed in m_spectrumData, and recovers the spectrum of each one.
+    /// @param[in] fftSize					Size of the FFT.
+    /// @param[out] firstSpectrum			Positive frequencies of the first signal (fftBins values).
+    /// @param[out] secondSpectrum			Positive frequencies of the second signal (fftBins values).
+    //----------------------------------------------------------------------------------------
+    void transformPackedFrame(int fftSize, dsp::Complex<float>* firstSpectrum, dsp::Complex<float>* secondSpectrum);
+
+    //----------------------------------------------------------------------------------------
+    /// Computes the reassigned spectrum of each analyzed channel over the frequency axis.
+    /// Every bin is moved to the frequency of the axis closest to its instantaneous frequency, where the loudest bin wins.
+    /// Bins whose group delay points outside of the current hop are left to the neighbouring frames.
+    /// The magnitudes are stored in m_visuData and their frequencies in m_reassignedFrequencies (channel after channel).
+    /// @param[in] frame					Audio frame.
+    /// @param[in] fftSize					Size of the FFT.
+    /// @param[in] hopSize					Number of analyzed samples between two consecutive frames.
+    /// @return								Number of analyzed channels.
+    //----------------------------------------------------------------------------------------
+    int reassignFrame(const FrameRegions& frame, int fftSize, int hopSize);
+
+    //----------------------------------------------------------------------------------------
+    /// Feeds the new samples of the current audio frame to the sliding DFTs, and stores the highest magnitude reached
+    /// by each watched frequency during the hop in m_visuData (on the closest frequency of the axis, channel after channel).
+    /// After a reset, the whole frame is fed first, so the first column doesn't wait for the delay lines to fill.
+    /// @param[in] frame					Audio frame.
+    /// @param[in] fftSize					Size of the FFT.
+    /// @param[in] hopSize					Number of new samples at the end of the frame.
+    /// @return								Number of analyzed channels.
+    //----------------------------------------------------------------------------------------
+    int watchFrequencies(const FrameRegions& frame, int fftSize, int hopSize);
+
+    //----------------------------------------------------------------------------------------
+    /// Mixes and windows the channels of the current audio frame according to the channel mode, then performs the FFT.
+    /// The magnitudes of each analyzed channel are stored in m_fftData, one after the other (fftBins values each).
+    /// The complex spectra are left in m_spectrumData, for the stages that need the phase.
+    /// @param[in] frame					Audio frame.
+    /// @param[in] fftSize					Size of the FFT.
+    /// @return								Number of analyzed channels.
+    //----------------------------------------------------------------------------------------
+    int transformFrame(const FrameRegions& frame, int fftSize);
+
+    //----------------------------------------------------------------------------------------
+    /// Precomputes how the FFT bins of the current plan are mapped to the frequency axis.
+    /// Should be called whenever the axis or the FFT size changes.
+    //----------------------------------------------------------------------------------------
+    void updateFrequencyMapping();
+
+    //----------------------------------------------------------------------------------------
+    /// Interpolates the FFT output over the frequency axis.
+    /// The lower frequencies use the precomputed interpolation matrix, the higher ones keep the loudest bin they cover.
+    /// On a perceptual axis, every frequency gets the energy of its triangular filter instead.
+    /// @param[in] inputData				FFT output (fftBins values of the current plan).
+    /// @param[out] outputData				Interpolated data (one value for each frequency of the axis).
+    /// @param[out] frequencies				Frequency of each interpolated value (one value for each frequency of the axis).
+    //----------------------------------------------------------------------------------------
+    void interpolateData(const float* inputData, float* outputData, float* frequencies);
+
+    //----------------------------------------------------------------------------------------
+    /// Converts the interpolated data to levels in dB and normalized levels.
+    /// With the adaptive level, the levels are normalized between the tracked noise floor and peak of the channel.
+    /// @param[in] channel					Channel of the data.
+    /// @param[in] inputData				Interpolated data (one value for each frequency of the axis).
+    /// @param[in] levelRange				Minimum and maximum levels of the FFT frame.
+    /// @param[out] dbLevels				Levels in dB (one value for each frequency of the axis).
+    /// @param[out] normalizedLevels		Normalized levels (one value for each frequency of the axis).
+    //----------------------------------------------------------------------------------------
+    void mapLevels(int channel, const float* inputData, Range<float> levelRange, float* dbLevels, float* normalizedLevels);
+
+    //----------------------------------------------------------------------------------------
+    /// Selects the tables of the current window for the current plan, and updates the level correction.
+    /// A Kaiser table is refilled if its beta parameter is outdated.
+    //----------------------------------------------------------------------------------------
+    void updateWindow();
+
+    // Audio structures
+    StereoRingBuffer& m_ringBuffer;			/// Ring buffer that holds the incoming audio data.
+    const int m_ringReader;					/// Index of the analyzer's reader in the ring buffer.
+    AudioBuffer<float>& m_readBuffer;		/// Temporary buffer to store the latest ring buffer's audio frame.
+    const double m_sampleRate;				/// Sample rate.
+    double m_analysisRate;					/// Sample rate of the analyzed signal, once decimated (analysis thread only).
+    Decimator m_decimator;					/// Decimator used when zooming on low frequencies.
+    AudioBuffer<float> m_decimatedData;		/// Latest decimated samples of each channel. The current frame is made of the last fftSize samples.
+
+    std::vector<std::unique_ptr<FFTPlan>> m_plans; /// Preallocated plans (one for each FFT order).
+    FFTPlan* m_plan = nullptr;				/// Plan currently used (analysis thread only).
+    WindowTables* m_window = nullptr;		/// Window of the current plan (analysis thread only).
+    float m_levelOffset = 0.0f;				/// Correction of the window in dB, added to every level (analysis thread only).
+
+    HeapBlock<float, true> m_fftData;		/// FFT output (complex values before unpacking, then magnitudes).
+    HeapBlock<dsp::Complex<float>, true> m_spectrumData; /// Packed FFT input, then complex spectra of the current frame (channel after channel).
+    HeapBlock<float, true> m_visuData;		/// Interpolated data of the current frame (channel after channel).
+    HeapBlock<float, true> m_mixedData;		/// Mixed channel of the current frame, left unwindowed (reassigned mode).
+    HeapBlock<dsp::Complex<float>, true> m_reassignmentSpectra; /// Spectra of the window, derivative and time-weighted window (one block of fftSize values each, channel after channel).
+    HeapBlock<float, true> m_reassignedFrequencies; /// Instantaneous frequency of each reassigned value (channel after channel).
+    SpectralAverager m_averager;			/// Averaged FFT output (used for smoother frequency resolution).
+    PartialTracker m_partialTrackers[maxChannels]; /// Partial tracks of each analyzed channel.
+    HeapBlock<float, true> m_binLevels;		/// Levels in dB of the averaged bins (partial tracking in FFT mode).
+    HeapBlock<float, true> m_binFrequencies; /// Frequency of each bin of the current plan. Rebuilt along with the matrix.
+    SpectralFeatureExtractor m_featureExtractor; /// Spectral features of the averaged data of each analyzed channel.
+    LevelRangeTracker m_levelRangeTracker;	/// Noise floor and peak of each analyzed channel (adaptive level).
+
+    FrequencyAxis<float> m_frequencyAxis;	/// Frequency axis used for frequency data scaling.
+    InterpolationMatrix m_interpolationMatrix; /// Interpolation weights of the lower frequencies. Rebuilt when the axis or the FFT size changes.
+    TriangularFilterbank m_filterbank;		/// Triangular filters of every frequency of a perceptual axis. Rebuilt along with the matrix, in FFT mode only.
+    std::vector<Range<int>> m_binRanges;	/// Bins covered by each higher frequency (the ones that are not interpolated). Rebuilt along with the matrix.
+    ConstantQKernel m_constantQKernel;		/// Spectral kernels of the constant-Q transform. Rebuilt along with the matrix, in constant-Q mode only.
+    std::vector<std::unique_ptr<SlidingDFTBank>> m_watchedBanks; /// Sliding DFTs of each analyzed channel. Rebuilt along with the matrix, in watched mode only.
+    int m_watchedRows[SlidingDFTBank::maxFrequencies];	/// Position on the axis of each watched frequency (-1 if out of range).
+    bool m_watchedBanksFilled = false;		/// False until the sliding DFTs have been fed a whole frame since their last reset.
+    FrameQueue<SpectralFrame> m_frameQueue;	/// Finished spectral frames waiting to be rendered.
+    HistoryBuffer<FeatureSnapshot> m_featureHistory; /// Spectral features of the latest frames.
+
+    // Parameters (written by the message thread, read by the analysis thread)
+    std::atomic<int> m_hopSize;				/// Number of samples between two consecutive spectral frames.
+    std::atomic<int> m_fftOrder;			/// Requested FFT order.
+    std::atomic<ChannelMode> m_channelMode { ChannelMode::Sum }; /// Requested channel mode.
+    std::atomic<TransformMode> m_transformMode { TransformMode::FFT }; /// Requested transform mode.
+    std::atomic<float> m_maxFrequency;		/// Requested maximum frequency of the frequency axis.
+    std::atomic<FrequencyAxis<float>::Distribution> m_distribution { FrequencyAxis<float>::Distribution::Logarithmic }; /// Requested frequency distribution.
+    std::atomic<WindowType> m_windowType { WindowType::Hann }; /// Requested window type.
+    std::atomic<float> m_kaiserBeta;		/// Requested beta parameter of the Kaiser window.
+    std::atomic<SpectralAverager::Mode> m_averagingMode { SpectralAverager::Mode::Boxcar }; /// Requested averaging mode.
+    std::atomic<int> m_averagingDepth;		/// Requested number of averaged frames (boxcar mode).
+    std::atomic<float> m_averagingTime;		/// Requested time constant in milliseconds (exponential mode).
+    std::atomic<float> m_attackTime;		/// Requested attack time in milliseconds (peak hold mode).
+    std::atomic<float> m_releaseTime;		/// Requested release time in milliseconds (peak hold mode).
+    std::atomic<float> m_holdTime;			/// Requested hold time in milliseconds (peak hold mode).
+    std::atomic_bool m_adaptativeLevel = false; /// If true, the level is normalized between the tracked noise floor and peak. If false, the original level is used for visualization.
+    std::atomic_bool m_clipLevel = false;	/// If true, the level is clipped to 0 dB. If false, the level is clipped to an arbitrary positive dB value.
+    std::atomic_bool m_partialTracking = false; /// If true, the peaks of the averaged frames are linked into partial tracks.
+    std::atomic_bool m_noiseLevelCorrection = false; /// If true, the levels are also corrected by the equivalent noise bandwidth of the window.
+    std::atomic<LatencyPolicy> m_latencyPolicy { LatencyPolicy::NewestFrames }; /// Requested latency policy.
+    std::atomic<int> m_maxPendingFrames { defaultMaxPendingFrames }; /// Maximum number of pending hops processed by a batch (NewestFrames policy).
+    std::atomic<double> m_timeBudget { defaultTimeBudget }; /// Maximum duration of a batch in milliseconds (TimeBudget policy).
+    std::atomic<float> m_watchedFrequencies[SlidingDFTBank::maxFrequencies]; /// Requested watched frequencies.
+    std::atomic<int> m_numWatchedFrequencies { 0 };	/// Requested number of watched frequencies.
+    std::atomic<uint32> m_watchedVersion { 0 };	/// Incremented once the watched frequencies are written.
+    uint32 m_currentWatchedVersion = 0;		/// Version of the watched frequencies currently applied (analysis thread only).
+    float m_currentMaxFrequency;			/// Maximum frequency currently applied to the frequency axis (analysis thread only).
+    ChannelMode m_currentChannelMode = ChannelMode::Sum; /// Channel mode currently applied (analysis thread only).
+    TransformMode m_currentTransformMode = TransformMode::FFT; /// Transform mode currently applied (analysis thread only).
+    bool m_currentPartialTracking = false;	/// Partial tracking state currently applied (analysis thread only).
+    WindowType m_currentWindowType = WindowType::Hann; /// Window type currently applied (analysis thread only).
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SpectrumAnalyzer)
+};
\ No newline at end of file
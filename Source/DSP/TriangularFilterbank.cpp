@@ -0,0 +1,98 @@
+//--------------------------------------------------------------------------------------------
+// Name: TriangularFilterbank.cpp
+// Author: Jérémi Panneton
+// Creation date: October 16th, 2026
+//--------------------------------------------------------------------------------------------
+
+#include "TriangularFilterbank.h"
+
+namespace
+{
+    //----------------------------------------------------------------------------------------
+    /// Returns the largest number of weights of a filterbank: every bin belongs to two filters at most,
+    /// a narrow filter holds two weights, and each row is padded to the alignment of the matrix.
+    //----------------------------------------------------------------------------------------
+    int getMaxWeights(int maxRows, int maxBins)
+    {
+        return 2 * (maxRows + maxBins) + (SparseRowMatrix::rowAlignment - 1) * maxRows;
+    }
+}
+
+TriangularFilterbank::TriangularFilterbank(int maxRows, int maxBins)
+    : m_matrix(maxRows, getMaxWeights(maxRows, maxBins))
+    , m_powers(static_cast<size_t>(maxBins))
+{
+}
+
+void TriangularFilterbank::build(const FrequencyAxis<float>& frequencyAxis, int fftBins, double sampleRate)
+{
+    m_matrix.clear();
+    m_numBins = fftBins;
+
+    const int resolution = frequencyAxis.getResolution();
+    jassert(resolution > 1);
+
+    // Bin k is centered on k * sampleRate / fftSize, with fftSize = 2 * fftBins
+    const float nyquistFrequency = static_cast<float>(sampleRate) / 2;
+    const float freqToBin = fftBins / nyquistFrequency;
+
+    for (int x = 0; x < resolution; ++x)
+    {
+        // The outer filters are as wide as their inner neighbor
+        const float center = frequencyAxis[x] * freqToBin;
+        const float left = x > 0 ? frequencyAxis[x - 1] * freqToBin : 2.0f * center - frequencyAxis[x + 1] * freqToBin;
+        const float right = x < resolution - 1 ? frequencyAxis[x + 1] * freqToBin : 2.0f * center - frequencyAxis[x - 1] * freqToBin;
+
+        if (right - left < 2.0f)
+        {
+            // Too narrow to hold a bin on each slope: interpolate the two closest bins instead
+            const int x1 = jlimit(0, fftBins - 1, static_cast<int>(center));
+            const int x2 = jmin(fftBins - 1, x1 + 1);
+            const float frac = jlimit(0.0f, 1.0f, center - x1);
+
+            m_matrix.beginRow(x1);
+            if (x2 != x1)
+            {
+                m_matrix.addWeight(1.0f - frac);
+                m_matrix.addWeight(frac);
+            }
+            else
+            {
+                // Last bin: both weights fall on it
+                m_matrix.addWeight(1.0f);
+            }
+        }
+        else
+        {
+            // Bins strictly inside the triangle
+            const int firstBin = jmax(0, static_cast<int>(std::floor(left)) + 1);
+            const int lastBin = jmin(fftBins - 1, static_cast<int>(std::ceil(right)) - 1);
+
+            m_matrix.beginRow(firstBin);
+            for (int bin = firstBin; bin <= lastBin; ++bin)
+            {
+                const float weight = bin <= center ? (bin - left) / (center - left) : (right - bin) / (right - center);
+                m_matrix.addWeight(weight);
+            }
+        }
+
+        m_matrix.endRow(fftBins);
+    }
+}
+
+void TriangularFilterbank::apply(const float* inputData, float* outputData) noexcept
+{
+    // The filters weight the squared magnitudes
+    FloatVectorOperations::multiply(m_powers, inputData, inputData, m_numBins);
+    m_matrix.apply(m_powers, outputData);
+
+    for (int row = 0; row < getNumRows(); ++row)
+    {
+        outputData[row] = std::sqrt(outputData[row]);
+    }
+}
+
+int TriangularFilterbank::getNumRows() const noexcept
+{
+    return m_matrix.getNumRows();
+}
\ No newline at end of file
@@ -0,0 +1,55 @@
+//--------------------------------------------------------------------------------------------
+// Name: TriangularFilterbank.h
+// Author: Jérémi Panneton
+// Creation date: October 16th, 2026
+//--------------------------------------------------------------------------------------------
+
+#pragma once
+
+#include "JuceHeader.h"
+#include "SparseRowMatrix.h"
+#include "Utilities/FrequencyAxis.h"
+
+//--------------------------------------------------------------------------------------------
+/// Sparse bank of triangular filters over the FFT bins, one for each frequency of a (perceptual) axis.
+/// Each filter rises from the previous frequency of the axis to its own and falls to the next one,
+/// like the usual mel filterbanks, so the whole spectrum is covered and every bin contributes to two filters at most.
+/// Filters narrower than two bins (lower frequencies) fall back to a linear interpolation of the power.
+/// The weights only depend on the axis layout and the number of bins, so they are computed once,
+/// and are held by a SparseRowMatrix like the InterpolationMatrix (the bins of a filter are contiguous).
+//--------------------------------------------------------------------------------------------
+class TriangularFilterbank
+{
+public:
+    //----------------------------------------------------------------------------------------
+    /// Constructor. Preallocates the filterbank, so that rebuilding it never allocates.
+    /// @param[in] maxRows					Maximum number of filters (resolution of the frequency axis).
+    /// @param[in] maxBins					Maximum number of FFT bins.
+    //----------------------------------------------------------------------------------------
+    TriangularFilterbank(int maxRows, int maxBins);
+
+    //----------------------------------------------------------------------------------------
+    /// Computes the weights of the filter centered on every frequency of the axis.
+    /// @param[in] frequencyAxis			Frequency axis holding the center frequencies.
+    /// @param[in] fftBins					Number of FFT bins.
+    /// @param[in] sampleRate				Sample rate.
+    //----------------------------------------------------------------------------------------
+    void build(const FrequencyAxis<float>& frequencyAxis, int fftBins, double sampleRate);
+
+    //----------------------------------------------------------------------------------------
+    /// Computes the energy of every filter: the weighted sum of the squared magnitudes of its bins.
+    /// @param[in] inputData				FFT magnitudes (fftBins values).
+    /// @param[out] outputData				Square root of the energy of each filter, so the output stays a magnitude.
+    //----------------------------------------------------------------------------------------
+    void apply(const float* inputData, float* outputData) noexcept;
+
+    //----------------------------------------------------------------------------------------
+    /// Returns the number of filters.
+    //----------------------------------------------------------------------------------------
+    int getNumRows() const noexcept;
+
+private:
+    SparseRowMatrix m_matrix;				/// Weights of each filter, over the FFT bins.
+    HeapBlock<float> m_powers;				/// Squared magnitudes of the bins being filtered.
+    int m_numBins = 0;						/// Number of FFT bins the filters were built for.
+};
\ No newline at end of file
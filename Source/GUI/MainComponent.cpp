@@ -32,6 +32,74 @@ MainComponent::MainComponent()
     addButton(m_lowFrequencyButton, "Low Frequency Mode", false);
     addButton(m_adaptiveLevelButton, "Adaptive Level", false);
     addButton(m_clipLevelButton, "Clip Level", false);
+    addButton(m_partialTrackingButton, "Partial Tracks", false);
+    addButton(m_noiseLevelButton, "Noise Level (ENBW)", false);
+
+    m_controlPanel.addAndMakeVisible(m_fftSizeBox);
+    for (int order = SpectrumAnalyzer::minFftOrder; order <= SpectrumAnalyzer::maxFftOrder; ++order)
+    {
+        // The FFT order is used as item ID
+        m_fftSizeBox.addItem("FFT Size: " + String(1 << order), order);
+    }
+    m_fftSizeBox.setSelectedId(SpectrumAnalyzer::defaultFftOrder, NotificationType::dontSendNotification);
+    m_fftSizeBox.onChange = [&] { comboBoxChanged(&m_fftSizeBox); };
+
+    m_controlPanel.addAndMakeVisible(m_channelModeBox);
+    // The channel mode + 1 is used as item ID (0 is reserved)
+    m_channelModeBox.addItem("Channels: Left", static_cast<int>(SpectrumAnalyzer::ChannelMode::Left) + 1);
+    m_channelModeBox.addItem("Channels: Right", static_cast<int>(SpectrumAnalyzer::ChannelMode::Right) + 1);
+    m_channelModeBox.addItem("Channels: Left + Right", static_cast<int>(SpectrumAnalyzer::ChannelMode::Sum) + 1);
+    m_channelModeBox.addItem("Channels: Mid", static_cast<int>(SpectrumAnalyzer::ChannelMode::Mid) + 1);
+    m_channelModeBox.addItem("Channels: Side", static_cast<int>(SpectrumAnalyzer::ChannelMode::Side) + 1);
+    m_channelModeBox.addItem("Channels: Dual (Left / Right)", static_cast<int>(SpectrumAnalyzer::ChannelMode::Dual) + 1);
+    m_channelModeBox.setSelectedId(static_cast<int>(SpectrumAnalyzer::ChannelMode::Sum) + 1, NotificationType::dontSendNotification);
+    m_channelModeBox.onChange = [&] { comboBoxChanged(&m_channelModeBox); };
+
+    m_controlPanel.addAndMakeVisible(m_averagingBox);
+    m_averagingBox.addItem("Averaging: Off", 1);
+    m_averagingBox.addItem("Averaging: 4 Frames", 2);
+    m_averagingBox.addItem("Averaging: 16 Frames", 3);
+    m_averagingBox.addItem("Averaging: Exponential (100 ms)", 4);
+    m_averagingBox.addItem("Averaging: Exponential (500 ms)", 5);
+    m_averagingBox.addItem("Averaging: Peak Hold", 6);
+    m_averagingBox.setSelectedId(2, NotificationType::dontSendNotification);
+    m_averagingBox.onChange = [&] { comboBoxChanged(&m_averagingBox); };
+
+    m_controlPanel.addAndMakeVisible(m_transformModeBox);
+    // The transform mode + 1 is used as item ID (0 is reserved)
+    m_transformModeBox.addItem("Transform: FFT", static_cast<int>(SpectrumAnalyzer::TransformMode::FFT) + 1);
+    m_transformModeBox.addItem("Transform: Constant-Q", static_cast<int>(SpectrumAnalyzer::TransformMode::ConstantQ) + 1);
+    m_transformModeBox.addItem("Transform: Reassigned", static_cast<int>(SpectrumAnalyzer::TransformMode::Reassigned) + 1);
+    m_transformModeBox.addItem("Transform: Watched Frequencies", static_cast<int>(SpectrumAnalyzer::TransformMode::Watched) + 1);
+    m_transformModeBox.setSelectedId(static_cast<int>(SpectrumAnalyzer::TransformMode::FFT) + 1, NotificationType::dontSendNotification);
+    m_transformModeBox.onChange = [&] { comboBoxChanged(&m_transformModeBox); };
+
+    m_controlPanel.addAndMakeVisible(m_windowBox);
+    m_windowBox.addItem("Window: Hann", 1);
+    m_windowBox.addItem("Window: Blackman-Harris", 2);
+    m_windowBox.addItem("Window: Flat Top", 3);
+    m_windowBox.addItem("Window: Kaiser (Beta 6)", 4);
+    m_windowBox.addItem("Window: Kaiser (Beta 12)", 5);
+    m_windowBox.setSelectedId(1, NotificationType::dontSendNotification);
+    m_windowBox.onChange = [&] { comboBoxChanged(&m_windowBox); };
+
+    m_controlPanel.addAndMakeVisible(m_latencyBox);
+    m_latencyBox.addItem("Latency: Process All Frames", 1);
+    m_latencyBox.addItem("Latency: Newest 8 Frames", 2);
+    m_latencyBox.addItem("Latency: 10 ms Budget", 3);
+    m_latencyBox.setSelectedId(2, NotificationType::dontSendNotification);
+    m_latencyBox.onChange = [&] { comboBoxChanged(&m_latencyBox); };
+
+    m_controlPanel.addAndMakeVisible(m_distributionBox);
+    // The distribution + 1 is used as item ID (0 is reserved)
+    using Distribution = FrequencyAxis<float>::Distribution;
+    m_distributionBox.addItem("Axis: Linear", static_cast<int>(Distribution::Linear) + 1);
+    m_distributionBox.addItem("Axis: Logarithmic", static_cast<int>(Distribution::Logarithmic) + 1);
+    m_distributionBox.addItem("Axis: Mel", static_cast<int>(Distribution::Mel) + 1);
+    m_distributionBox.addItem("Axis: Bark", static_cast<int>(Distribution::Bark) + 1);
+    m_distributionBox.addItem("Axis: ERB", static_cast<int>(Distribution::ERB) + 1);
+    m_distributionBox.setSelectedId(static_cast<int>(Distribution::Logarithmic) + 1, NotificationType::dontSendNotification);
+    m_distributionBox.onChange = [&] { comboBoxChanged(&m_distributionBox); };
 }
 
 MainComponent::~MainComponent()
@@ -40,12 +108,27 @@ MainComponent::~MainComponent()
 
 void MainComponent::prepareToPlay(double sampleRate)
 {
+    m_sampleRate = sampleRate;
+
+    // Every visualizer reads the same stream with its own reader. The latest audio matters more than complete audio here.
+    m_ringBuffer = std::make_unique<StereoRingBuffer>(2, SpectrumAnalyzer::maxFftSize * 10, numVisualizers);
+    m_ringBuffer->setOverflowPolicy(AbstractRingBuffer::OverflowPolicy::OverwriteOldest);
+
     // Create visualizers
-    m_spectrogram2D = std::make_unique<Spectrogram2D>(sampleRate, m_statusBar);
+    m_spectrogram2D = std::make_unique<Spectrogram2D>(*m_ringBuffer, 0, sampleRate, m_statusBar);
     addChildComponent(m_spectrogram2D.get());
 
-    m_spectrogram3D = std::make_unique<Spectrogram3D>(sampleRate, m_statusBar);
+    m_spectrogram3D = std::make_unique<Spectrogram3D>(*m_ringBuffer, 1, sampleRate, m_statusBar);
     addChildComponent(m_spectrogram3D.get());
+
+    // Apply the current settings
+    comboBoxChanged(&m_fftSizeBox);
+    comboBoxChanged(&m_channelModeBox);
+    comboBoxChanged(&m_averagingBox);
+    comboBoxChanged(&m_transformModeBox);
+    comboBoxChanged(&m_windowBox);
+    comboBoxChanged(&m_latencyBox);
+    comboBoxChanged(&m_distributionBox);
 }
 
 void MainComponent::releaseResources()
@@ -63,13 +146,17 @@ void MainComponent::releaseResources()
         removeChildComponent(m_spectrogram3D.get());
         m_spectrogram3D = nullptr;
     }
+
+    // The visualizers don't read it anymore
+    m_ringBuffer = nullptr;
 }
 
 void MainComponent::processBlock(AudioBuffer<float>& buffer)
 {
-    if (m_activeVisualizer)
+    // Copied once, whatever the number of visualizers reading it
+    if (m_ringBuffer)
     {
-        m_activeVisualizer->processBlock(buffer);
+        m_ringBuffer->writeSamples(buffer);
     }
 }
 
@@ -105,6 +192,18 @@ void MainComponent::resized()
     m_lowFrequencyButton.setBounds(panelPadding, CONTROL_HEIGHT * 3, buttonWidth, buttonHeight);
     m_adaptiveLevelButton.setBounds(panelPadding, CONTROL_HEIGHT * 4, buttonWidth, buttonHeight);
     m_clipLevelButton.setBounds(panelPadding, CONTROL_HEIGHT * 5, buttonWidth, buttonHeight);
+    m_partialTrackingButton.setBounds(panelPadding, CONTROL_HEIGHT * 6, buttonWidth, buttonHeight);
+    m_noiseLevelButton.setBounds(panelPadding, CONTROL_HEIGHT * 7, buttonWidth, buttonHeight);
+
+    // Combo boxes
+    const int comboBoxX = panelPadding + buttonWidth + buttonMargin;
+    m_fftSizeBox.setBounds(comboBoxX, CONTROL_HEIGHT, buttonWidth - buttonMargin, buttonHeight);
+    m_channelModeBox.setBounds(comboBoxX, CONTROL_HEIGHT * 2, buttonWidth - buttonMargin, buttonHeight);
+    m_averagingBox.setBounds(comboBoxX, CONTROL_HEIGHT * 3, buttonWidth - buttonMargin, buttonHeight);
+    m_transformModeBox.setBounds(comboBoxX, CONTROL_HEIGHT * 4, buttonWidth - buttonMargin, buttonHeight);
+    m_windowBox.setBounds(comboBoxX, CONTROL_HEIGHT * 5, buttonWidth - buttonMargin, buttonHeight);
+    m_latencyBox.setBounds(comboBoxX, CONTROL_HEIGHT * 6, buttonWidth - buttonMargin, buttonHeight);
+    m_distributionBox.setBounds(comboBoxX, CONTROL_HEIGHT * 7, buttonWidth - buttonMargin, buttonHeight);
 
     if (m_spectrogram2D)
         m_spectrogram2D->setBounds(0, 0, width, statusBarY);
@@ -147,8 +246,9 @@ void MainComponent::buttonClicked(Button* button)
     else if (button == &m_lowFrequencyButton)
     {
         const ColourGradient gradient = !buttonToggleState ? ColorGradients::getDefaultGradient() : ColorGradients::getRedGradient();
-        m_spectrogram2D->setMaxFrequency(!buttonToggleState ? 44100.0f / 2.0f : 200.0f, gradient);
-        m_spectrogram3D->setMaxFrequency(!buttonToggleState ? 44100.0f / 2.0f : 200.0f, gradient);
+        const float maxFrequency = !buttonToggleState ? static_cast<float>(m_sampleRate) / 2.0f : 200.0f;
+        m_spectrogram2D->setMaxFrequency(maxFrequency, gradient);
+        m_spectrogram3D->setMaxFrequency(maxFrequency, gradient);
     }
     else if (button == &m_adaptiveLevelButton)
     {
@@ -160,4 +260,97 @@ void MainComponent::buttonClicked(Button* button)
         m_spectrogram2D->setClipLevel(buttonToggleState);
         m_spectrogram3D->setClipLevel(buttonToggleState);
     }
+    else if (button == &m_partialTrackingButton)
+    {
+        m_spectrogram2D->setPartialTracking(buttonToggleState);
+        m_spectrogram3D->setPartialTracking(buttonToggleState);
+    }
+    else if (button == &m_noiseLevelButton)
+    {
+        m_spectrogram2D->setNoiseLevelCorrection(buttonToggleState);
+        m_spectrogram3D->setNoiseLevelCorrection(buttonToggleState);
+    }
+}
+
+void MainComponent::comboBoxChanged(ComboBox* comboBox)
+{
+    // Visualizers are only created when playback is prepared
+    if (!m_spectrogram2D || !m_spectrogram3D)
+        return;
+
+    if (comboBox == &m_fftSizeBox)
+    {
+        const int fftOrder = m_fftSizeBox.getSelectedId();
+        m_spectrogram2D->setFftOrder(fftOrder);
+        m_spectrogram3D->setFftOrder(fftOrder);
+    }
+    else if (comboBox == &m_channelModeBox)
+    {
+        const auto channelMode = static_cast<SpectrumAnalyzer::ChannelMode>(m_channelModeBox.getSelectedId() - 1);
+        m_spectrogram2D->setChannelMode(channelMode);
+        m_spectrogram3D->setChannelMode(channelMode);
+    }
+    else if (comboBox == &m_averagingBox)
+    {
+        SpectralAverager::Settings settings;
+        switch (m_averagingBox.getSelectedId())
+        {
+        case 1:
+            settings.boxcarDepth = 1;
+            break;
+        case 2:
+            settings.boxcarDepth = 4;
+            break;
+        case 3:
+            settings.boxcarDepth = 16;
+            break;
+        case 4:
+            settings.mode = SpectralAverager::Mode::Exponential;
+            settings.timeConstant = 100.0f;
+            break;
+        case 5:
+            settings.mode = SpectralAverager::Mode::Exponential;
+            settings.timeConstant = 500.0f;
+            break;
+        case 6:
+            settings.mode = SpectralAverager::Mode::PeakHold;
+            break;
+        default:
+            break;
+        }
+
+        m_spectrogram2D->setAveraging(settings);
+        m_spectrogram3D->setAveraging(settings);
+    }
+    else if (comboBox == &m_transformModeBox)
+    {
+        const auto transformMode = static_cast<SpectrumAnalyzer::TransformMode>(m_transformModeBox.getSelectedId() - 1);
+        m_spectrogram2D->setTransformMode(transformMode);
+        m_spectrogram3D->setTransformMode(transformMode);
+    }
+    else if (comboBox == &m_windowBox)
+    {
+        using WindowType = SpectrumAnalyzer::WindowType;
+        const int selectedId = m_windowBox.getSelectedId();
+        const WindowType windowTypes[] = { WindowType::Hann, WindowType::BlackmanHarris, WindowType::FlatTop, WindowType::Kaiser, WindowType::Kaiser };
+        const float kaiserBeta = selectedId == 5 ? 12.0f : 6.0f;
+
+        m_spectrogram2D->setWindow(windowTypes[jlimit(1, 5, selectedId) - 1], kaiserBeta);
+        m_spectrogram3D->setWindow(windowTypes[jlimit(1, 5, selectedId) - 1], kaiserBeta);
+    }
+    else if (comboBox == &m_latencyBox)
+    {
+        using LatencyPolicy = SpectrumAnalyzer::LatencyPolicy;
+        const LatencyPolicy policies[] = { LatencyPolicy::ProcessAll, LatencyPolicy::NewestFrames, LatencyPolicy::TimeBudget };
+        const auto policy = policies[jlimit(1, 3, m_latencyBox.getSelectedId()) - 1];
+
+        m_spectrogram2D->setLatencyPolicy(policy);
+        m_spectrogram3D->setLatencyPolicy(policy);
+    }
+    else if (comboBox == &m_distributionBox)
+    {
+        const auto distribution = static_cast<FrequencyAxis<float>::Distribution>(m_distributionBox.getSelectedId() - 1);
+        m_spectrogram2D->setFrequencyDistribution(distribution);
+        m_spectrogram3D->setFrequencyDistribution(distribution);
+    }
 }
\ No newline at end of file
@@ -71,6 +71,12 @@ public:
     //----------------------------------------------------------------------------------------
     void buttonClicked(Button* button);
 
+    //----------------------------------------------------------------------------------------
+    /// Called when the selected item of a combo box is changed.
+    /// @param[in] comboBox					Combo box being changed.
+    //----------------------------------------------------------------------------------------
+    void comboBoxChanged(ComboBox* comboBox);
+
 private:
     static constexpr float VISUALIZER_RATIO = 0.725f;
     static constexpr int CONTROL_HEIGHT = 25;
@@ -84,9 +90,20 @@ private:
     ToggleButton m_lowFrequencyButton;
     ToggleButton m_adaptiveLevelButton;
     ToggleButton m_clipLevelButton;
+    ToggleButton m_partialTrackingButton;
+    ToggleButton m_noiseLevelButton;
+    ComboBox m_fftSizeBox;
+    ComboBox m_channelModeBox;
+    ComboBox m_averagingBox;
+    ComboBox m_transformModeBox;
+    ComboBox m_windowBox;
+    ComboBox m_latencyBox;
+    ComboBox m_distributionBox;
 
     // Audio buffer
-    std::unique_ptr<RingBuffer<float>> m_ringBuffer;
+    enum { numVisualizers = 2 };						/// Number of readers of the ring buffer (one for each visualizer).
+    std::unique_ptr<StereoRingBuffer> m_ringBuffer;		/// Incoming audio data, shared by every visualizer.
+    double m_sampleRate = 44100.0;
 
     // Visualizers
     std::unique_ptr<Spectrogram2D> m_spectrogram2D;
@@ -6,13 +6,16 @@
 
 #include "OpenGLComponent.h"
 
-OpenGLComponent::OpenGLComponent(int readSize, double sampleRate, bool continuousRepaint)
+OpenGLComponent::OpenGLComponent(StereoRingBuffer& ringBuffer, int ringReader, int readSize, double sampleRate, bool continuousRepaint)
     : m_backgroundColor(getLookAndFeel().findColour(ResizableWindow::backgroundColourId))
-    , m_ringBuffer(2, readSize * 10)
+    , m_ringBuffer(ringBuffer)
+    , m_ringReader(ringReader)
     , m_readBuffer(2, readSize)
     , m_sampleRate(sampleRate)
 {
     m_readBuffer.clear();
+    // Nothing is read until the component is started
+    m_ringBuffer.setReaderActive(m_ringReader, false);
 
     m_openGLContext.setOpenGLVersionRequired(OpenGLContext::OpenGLVersion::openGL3_2);
     m_openGLContext.setComponentPaintingEnabled(false);
@@ -33,19 +36,14 @@ OpenGLComponent::~OpenGLComponent()
 
 void OpenGLComponent::start() noexcept
 {
-    m_ringBuffer.clear();
+    m_ringBuffer.setReaderActive(m_ringReader, true);
     m_openGLContext.setContinuousRepainting(true);
 }
 
 void OpenGLComponent::stop() noexcept
 {
     m_openGLContext.setContinuousRepainting(false);
-    m_ringBuffer.clear();
-}
-
-void OpenGLComponent::processBlock(const AudioBuffer<float>& buffer)
-{
-    m_ringBuffer.writeSamples(buffer);
+    m_ringBuffer.setReaderActive(m_ringReader, false);
 }
 
 int OpenGLComponent::getReadSize() const noexcept
@@ -57,7 +55,7 @@ void OpenGLComponent::shutdownOpenGL()
 {
     m_openGLContext.setContinuousRepainting(false);
     m_openGLContext.detach();
-    m_ringBuffer.clear();
+    m_ringBuffer.setReaderActive(m_ringReader, false);
 }
 
 void OpenGLComponent::newOpenGLContextCreated()
@@ -18,12 +18,14 @@ class OpenGLComponent : public Component, private OpenGLRenderer
 {
 protected:
     //----------------------------------------------------------------------------------------
-    /// Constructor.
-    /// @param[in] readSize                 Number of samples to read from the ring buffer before each render.
+    /// Constructor. The reader stays detached from the ring buffer until the component is started.
+    /// @param[in] ringBuffer               Ring buffer that holds the incoming audio data (shared by every visualizer).
+    /// @param[in] ringReader               Index of the component's reader in the ring buffer.
+    /// @param[in] readSize                 Number of samples to read from the ring buffer for each analysis frame.
     /// @param[in] sampleRate               Sample rate.
     /// @param[in] continuousRepaint        True if OpenGL should render at a constant rate. False if OpenGL should render only on repaint event.
     //----------------------------------------------------------------------------------------
-    OpenGLComponent(int readSize, double sampleRate, bool continuousRepaint);
+    OpenGLComponent(StereoRingBuffer& ringBuffer, int ringReader, int readSize, double sampleRate, bool continuousRepaint);
 
     //----------------------------------------------------------------------------------------
     /// Destructor.
@@ -69,25 +71,19 @@ protected:
 
 public:
     //----------------------------------------------------------------------------------------
-    /// Sets automatic rendering (constant rate).
+    /// Sets automatic rendering (constant rate), and attaches the reader to the ring buffer (starting with an empty queue).
     //----------------------------------------------------------------------------------------
-    void start() noexcept;
+    virtual void start() noexcept;
 
     //----------------------------------------------------------------------------------------
-    /// Sets manual rendering (on repaint event).
+    /// Sets manual rendering (on repaint event), and detaches the reader from the ring buffer so it doesn't hold back the writer.
     /// This usually stops rendering since user needs to explicitly call OpenGLContext::triggerRepaint().
     //----------------------------------------------------------------------------------------
-    void stop() noexcept;
+    virtual void stop() noexcept;
 
     //----------------------------------------------------------------------------------------
-    /// Called during playback to add the incoming audio blocks to the ring buffer.
-    /// @param[in] buffer					Incoming audio buffer.
-    //----------------------------------------------------------------------------------------
-    void processBlock(const AudioBuffer<float>& buffer);
-
-    //----------------------------------------------------------------------------------------
-    /// Returns the number of samples to read from the ring buffer before each render.
-    /// @return                             Number of samples to read from the ring buffer before each render.
+    /// Returns the number of samples to read from the ring buffer for each analysis frame.
+    /// @return                             Number of samples to read from the ring buffer for each analysis frame.
     //----------------------------------------------------------------------------------------
     int getReadSize() const noexcept;
 
@@ -112,7 +108,8 @@ protected:
     std::unique_ptr<ShaderUniforms> m_uniforms;		/// Shader program's uniform variables.
     Colour m_backgroundColor;						/// Color used when clearing the viewport.
 
-    RingBuffer<float> m_ringBuffer;		/// Ring buffer that holds the incoming audio data.
+    StereoRingBuffer& m_ringBuffer;		/// Ring buffer that holds the incoming audio data (shared by every visualizer).
+    const int m_ringReader;				/// Index of the component's reader in the ring buffer.
     AudioBuffer<float> m_readBuffer;	/// Temporary buffer to store the latest ring buffer's audio frame.
     const double m_sampleRate = 0.0;    /// Sample rate.
 
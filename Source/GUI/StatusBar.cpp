@@ -11,16 +11,25 @@ StatusBar::StatusBar()
     addAndMakeVisible(m_fpsLabel);
     addAndMakeVisible(m_frequencyLabel);
     addAndMakeVisible(m_levelLabel);
+    addAndMakeVisible(m_partialLabel);
+    addAndMakeVisible(m_featureLabel);
+    addAndMakeVisible(m_streamLabel);
 }
 
-void StatusBar::update(unsigned int fps, float frequency, float level)
+void StatusBar::update(const StatusInfo& info)
 {
     // Parameters must be captured by copy! Otherwise, referenced parameters will be invalid at call time.
-    MessageManager::callAsync([&, fps, frequency, level]
+    MessageManager::callAsync([this, info]
     {
-        m_fpsLabel.setText("FPS: " + String(fps), NotificationType::dontSendNotification);
-        m_frequencyLabel.setText("Frequency: " + String(frequency), NotificationType::dontSendNotification);
-        m_levelLabel.setText("Level: " + String(static_cast<int>(level)), NotificationType::dontSendNotification);
+        m_fpsLabel.setText("FPS: " + String(info.fps), NotificationType::dontSendNotification);
+        m_frequencyLabel.setText("Frequency: " + String(info.frequency), NotificationType::dontSendNotification);
+        m_levelLabel.setText("Level: " + String(static_cast<int>(info.level)), NotificationType::dontSendNotification);
+        m_partialLabel.setText("Partials: " + String(info.numPartials) + (info.numPartials > 0 ? " (" + String(info.partialFrequency, 1) + " Hz)" : String()),
+                               NotificationType::dontSendNotification);
+        m_featureLabel.setText("Centroid: " + String(static_cast<int>(info.centroid)) + " Hz, Flatness: " + String(info.flatness, 2),
+                               NotificationType::dontSendNotification);
+        m_streamLabel.setText("Latency: " + String(info.latency, 1) + " ms, Overwritten: " + String(info.numOverwritten) + ", Dropped: " + String(info.numDropped),
+                              NotificationType::dontSendNotification);
     });
 }
 
@@ -28,7 +37,10 @@ void StatusBar::resized()
 {
     const int width = getWidth();
     const int height = getHeight();
-    m_fpsLabel.setBounds(0, 0, width / 8, height);
-    m_frequencyLabel.setBounds(width / 8, 0, width / 4, height);
-    m_levelLabel.setBounds(width / 8 + width / 4, 0, width / 4, height);
+    m_fpsLabel.setBounds(0, 0, width / 12, height);
+    m_frequencyLabel.setBounds(width / 12, 0, width / 8, height);
+    m_levelLabel.setBounds(width / 12 + width / 8, 0, width / 12, height);
+    m_partialLabel.setBounds(width / 6 + width / 8, 0, width / 6, height);
+    m_featureLabel.setBounds(width / 3 + width / 8, 0, width / 4, height);
+    m_streamLabel.setBounds(width / 3 + width / 8 + width / 4, 0, width - width / 3 - width / 8 - width / 4, height);
 }
\ No newline at end of file
@@ -14,6 +14,23 @@
 class StatusBar : public Component
 {
 public:
+    //----------------------------------------------------------------------------------------
+    /// Values displayed on the status bar.
+    //----------------------------------------------------------------------------------------
+    struct StatusInfo
+    {
+        unsigned int fps = 0;           /// Current FPS of the visualizer.
+        float frequency = 0.0f;         /// Frequency currently hovered by mouse.
+        float level = 0.0f;             /// Level in dB of the frequency hovered by the mouse.
+        int numPartials = 0;            /// Number of partials currently tracked.
+        float partialFrequency = 0.0f;  /// Frequency of the loudest partial currently tracked.
+        float centroid = 0.0f;          /// Spectral centroid of the latest frame.
+        float flatness = 0.0f;          /// Spectral flatness of the latest frame.
+        uint64 numDropped = 0;          /// Number of samples dropped by the ring buffer so far.
+        uint64 numOverwritten = 0;      /// Number of unread samples overwritten in the ring buffer so far.
+        double latency = 0.0;           /// Audio-to-screen latency in milliseconds.
+    };
+
     //----------------------------------------------------------------------------------------
     /// Default constructor.
     //----------------------------------------------------------------------------------------
@@ -21,11 +38,9 @@ public:
 
     //----------------------------------------------------------------------------------------
     /// Updates the displayed values on the status bar.
-    /// @param[in] fps				        Current FPS of the visualizer.
-    /// @param[in] frequency				Frequency currently hovered by mouse.
-    /// @param[in] level				    Level in dB of the frequency hovered by the mouse.
+    /// @param[in] info						Values to display.
     //----------------------------------------------------------------------------------------
-    void update(unsigned int fps, float frequency, float level);
+    void update(const StatusInfo& info);
 
     //----------------------------------------------------------------------------------------
     /// Resizes UI elements according to the status bar size (JUCE, not OpenGL).
@@ -36,4 +51,7 @@ private:
     Label m_fpsLabel;           /// Current FPS of the visualizer.
     Label m_frequencyLabel;     /// Frequency currently hovered by mouse.
     Label m_levelLabel;         /// Level in dB of the frequency hovered by the mouse.
+    Label m_partialLabel;       /// Number of partials currently tracked, and frequency of the loudest one.
+    Label m_featureLabel;       /// Spectral centroid and flatness of the latest frame.
+    Label m_streamLabel;        /// Health of the audio stream (latency and samples lost by the ring buffer).
 };
\ No newline at end of file
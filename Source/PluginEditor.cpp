@@ -12,7 +12,7 @@ PluginEditor::PluginEditor(PluginProcessor& processor)
     , m_processor(processor)
 {
     // Size needs to be set before construction!
-    setSize(700, 700);
+    setSize(700, 800);
     addAndMakeVisible(m_processor.m_visualizer);
 }
 
@@ -6,10 +6,13 @@
 
 #include "AbstractRingBuffer.h"
 
-AbstractRingBuffer::AbstractRingBuffer(int capacity) noexcept
+AbstractRingBuffer::AbstractRingBuffer(int capacity, int numReaders) noexcept
     : m_bufferSize(capacity)
+    , m_numReaders(jlimit(1, static_cast<int>(maxReaders), numReaders))
 {
     jassert(m_bufferSize > 0);
+    jassert(numReaders > 0 && numReaders <= maxReaders);
+    m_readers[0].active = true;
 }
 
 void AbstractRingBuffer::setTotalSize(int capacity) noexcept
@@ -24,22 +27,142 @@ int AbstractRingBuffer::getTotalSize() const noexcept
     return m_bufferSize;
 }
 
+int AbstractRingBuffer::getNumReaders() const noexcept
+{
+    return m_numReaders;
+}
+
+void AbstractRingBuffer::setOverflowPolicy(OverflowPolicy policy) noexcept
+{
+    m_overflowPolicy = policy;
+}
+
+uint64 AbstractRingBuffer::getNumDropped() const noexcept
+{
+    return m_numDropped.load(std::memory_order_relaxed);
+}
+
+uint64 AbstractRingBuffer::getNumOverwritten() const noexcept
+{
+    return m_numOverwritten.load(std::memory_order_relaxed);
+}
+
+void AbstractRingBuffer::setReaderActive(int reader, bool active) noexcept
+{
+    jassert(reader >= 0 && reader < m_numReaders);
+
+    // The head is moved before the writer can see the reader, so it never holds back the writer with stale items
+    if (active)
+        resetReader(reader);
+
+    m_readers[reader].active.store(active, std::memory_order_release);
+}
+
 int AbstractRingBuffer::getFreeSpace() const noexcept
 {
-    return getTotalSize() - getNumReady() - 1;
+    const auto writePosition = m_writePosition.load();
+    int maxNumReady = 0;
+    for (int i = 0; i < m_numReaders; ++i)
+    {
+        if (m_readers[i].active.load())
+            maxNumReady = jmax(maxNumReady, static_cast<int>(writePosition - m_readers[i].readPosition.load()));
+    }
+
+    return getTotalSize() - maxNumReady - 1;
+}
+
+int AbstractRingBuffer::getNumReady(int reader) const noexcept
+{
+    jassert(reader >= 0 && reader < m_numReaders);
+    // The read position first: a newer write position only makes the difference larger, never negative
+    const auto readPosition = m_readers[reader].readPosition.load();
+    return static_cast<int>(m_writePosition.load() - readPosition);
+}
+
+int64 AbstractRingBuffer::getWritePosition() const noexcept
+{
+    return m_writePosition.load(std::memory_order_acquire);
+}
+
+int64 AbstractRingBuffer::getReadPosition(int reader) const noexcept
+{
+    jassert(reader >= 0 && reader < m_numReaders);
+    return m_readers[reader].readPosition.load(std::memory_order_acquire);
 }
 
-int AbstractRingBuffer::getNumReady() const noexcept
+void AbstractRingBuffer::resetReader(int reader) noexcept
 {
-    const auto head = m_head.load();
-    const auto tail = m_tail.load();
-    return tail >= head ? (tail - head) : (getTotalSize() - (head - tail));
+    jassert(reader >= 0 && reader < m_numReaders);
+    m_readers[reader].readPosition.store(m_writePosition.load(std::memory_order_acquire), std::memory_order_release);
 }
 
 void AbstractRingBuffer::reset() noexcept
 {
-    m_tail = 0;
-    m_head = 0;
+    // The positions keep counting, only the tail and the heads go back to the first index
+    m_positionOffset = m_writePosition.load();
+    for (auto& reader : m_readers)
+        reader.readPosition = m_positionOffset;
+}
+
+bool AbstractRingBuffer::peek(int numToRead, PendingRead& pendingRead, int reader) const noexcept
+{
+    jassert(reader >= 0 && reader < m_numReaders);
+
+    // Acquire, because the writer thread pushes the head forward when it overwrites unread items
+    const auto readPosition = m_readers[reader].readPosition.load(std::memory_order_acquire);
+    // Acquire, because the writer thread is the one that changes m_writePosition
+    const auto writePosition = m_writePosition.load(std::memory_order_acquire);
+
+    // Equivalent of calling getNumReady(), but faster since the atomic accesses
+    // are already done and more optimized
+    const auto numReady = static_cast<int>(writePosition - readPosition);
+    if (numToRead > numReady)
+        return false;
+
+    pendingRead.blocks = generateResult(getTailIndex(readPosition), getTailIndex(writePosition), numToRead);
+    pendingRead.position = readPosition;
+    pendingRead.reader = reader;
+    return true;
+}
+
+bool AbstractRingBuffer::commit(const PendingRead& pendingRead, int numRead) noexcept
+{
+    jassert(numRead >= 0 && numRead <= pendingRead.blocks.blockSize1 + pendingRead.blocks.blockSize2);
+
+    // Release, because the writer thread may try to acquire the head.
+    // If the writer has moved the head in the meantime, the items were being overwritten while being read.
+    // The read positions never wrap, so a head moved by a whole lap can't be mistaken for the peeked one.
+    auto expectedPosition = pendingRead.position;
+    return m_readers[pendingRead.reader].readPosition.compare_exchange_strong(expectedPosition, pendingRead.position + numRead, std::memory_order_acq_rel);
+}
+
+void AbstractRingBuffer::makeRoom(int64 writePosition, int numToWrite) noexcept
+{
+    const int maxNumReady = getTotalSize() - 1 - numToWrite;
+    int maxNumOverwritten = 0;
+
+    for (int i = 0; i < m_numReaders; ++i)
+    {
+        if (!m_readers[i].active.load(std::memory_order_acquire))
+            continue;
+
+        // The reader may move its own head at the same time, so the new head is only set if it hasn't changed
+        auto readPosition = m_readers[i].readPosition.load(std::memory_order_acquire);
+        for (;;)
+        {
+            const int numOverwritten = static_cast<int>(writePosition - readPosition) - maxNumReady;
+            if (numOverwritten <= 0)
+                break;
+
+            if (m_readers[i].readPosition.compare_exchange_weak(readPosition, readPosition + numOverwritten, std::memory_order_acq_rel))
+            {
+                maxNumOverwritten = jmax(maxNumOverwritten, numOverwritten);
+                break;
+            }
+        }
+    }
+
+    m_numOverwritten.store(m_numOverwritten.load(std::memory_order_relaxed) + static_cast<uint64>(maxNumOverwritten), std::memory_order_relaxed);
 }
 
 AbstractRingBuffer::OperationResult AbstractRingBuffer::generateResult(int firstIndex, int lastIndex, int blockSize) const noexcept
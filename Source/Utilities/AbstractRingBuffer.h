@@ -14,16 +14,59 @@
 #include <new>
 
 //--------------------------------------------------------------------------------------------
-/// Encapsulates the logic required to implement a single-reader single-writer lock-free FIFO (doesn't hold any data).
+/// Encapsulates the logic required to implement a single-writer lock-free FIFO (doesn't hold any data).
+/// The FIFO is broadcast to several readers: each one has its own read cursor and sees every item written while
+/// it's active, and the slowest active reader defines the free space. Each reader should only be used by a single thread.
+/// When the FIFO is full, the writer either drops the new items or overwrites the oldest ones (see OverflowPolicy).
+/// The tail is kept as a monotonic count of the written items (the write position), so every item has a stable position in the stream.
+/// The heads are monotonic read positions as well, so a head pushed a whole lap forward by the writer never looks unchanged to its reader.
 //--------------------------------------------------------------------------------------------
 class AbstractRingBuffer
 {
 public:
+    enum
+    {
+        maxReaders = 4
+    };
+
+    //----------------------------------------------------------------------------------------
+    /// Defines what the writer does with items that don't fit in the free space.
     //----------------------------------------------------------------------------------------
-    /// Constructor.
+    enum class OverflowPolicy
+    {
+        DropNewest,		/// The new items are discarded (lossless for the readers, but they may stall on old data).
+        OverwriteOldest	/// The slow readers are pushed forward, so the newest items always get in (lossy, meant for visualization).
+    };
+
+    //----------------------------------------------------------------------------------------
+    /// Wraps the information needed to perform the actual read or write operation.
+    /// Since it's a ring buffer, the requested block can span from the end of the buffer to the beginning.
+    /// So, the requested block is handled as two separate blocks.
+    //----------------------------------------------------------------------------------------
+    struct OperationResult
+    {
+        int startIndex1;	/// Index of the first part of the requested block.
+        int blockSize1;		/// Size of the first part of the requested block.
+        int startIndex2;	/// Index of the second part of the requested block (always 0).
+        int blockSize2;		/// Size of the second part of the requested block (0 if no second part).
+    };
+
+    //----------------------------------------------------------------------------------------
+    /// Items being read in place: they stay in the buffer until the read is committed (see peek() and commit()).
+    //----------------------------------------------------------------------------------------
+    struct PendingRead
+    {
+        OperationResult blocks;	/// Location of the peeked items.
+        int64 position = 0;		/// Position of the first peeked item in the stream (read position of the reader when the items were peeked).
+        int reader = 0;			/// Index of the reader.
+    };
+
+    //----------------------------------------------------------------------------------------
+    /// Constructor. Only the first reader is active at first.
     /// @param[in] capacity					Total size of the buffer being managed.
+    /// @param[in] numReaders				Number of read cursors (at most maxReaders).
     //----------------------------------------------------------------------------------------
-    AbstractRingBuffer(int capacity) noexcept;
+    AbstractRingBuffer(int capacity, int numReaders = 1) noexcept;
 
     //----------------------------------------------------------------------------------------
     /// Updates the total size of the buffer being managed.
@@ -38,34 +81,90 @@ public:
     int getTotalSize() const noexcept;
 
     //----------------------------------------------------------------------------------------
-    /// Returns the number of items that can be added to the buffer without overflowing.
+    /// Returns the number of read cursors.
+    //----------------------------------------------------------------------------------------
+    int getNumReaders() const noexcept;
+
+    //----------------------------------------------------------------------------------------
+    /// Sets what the writer does with items that don't fit in the free space. Can be called from any thread.
+    /// @param[in] policy					Overflow policy.
+    //----------------------------------------------------------------------------------------
+    void setOverflowPolicy(OverflowPolicy policy) noexcept;
+
+    //----------------------------------------------------------------------------------------
+    /// Returns the total number of items discarded by the writer because they didn't fit. Can be called from any thread.
+    //----------------------------------------------------------------------------------------
+    uint64 getNumDropped() const noexcept;
+
+    //----------------------------------------------------------------------------------------
+    /// Returns the total number of unread items overwritten by the writer (counted once for the slowest reader). Can be called from any thread.
+    //----------------------------------------------------------------------------------------
+    uint64 getNumOverwritten() const noexcept;
+
+    //----------------------------------------------------------------------------------------
+    /// Attaches or detaches a reader. An inactive reader doesn't hold back the writer anymore.
+    /// Once activated, the reader starts at the current write position (it only sees the items written from now on).
+    /// Can be called while writing, but only from the reader's thread (or while it doesn't read).
+    /// @param[in] reader					Index of the reader.
+    /// @param[in] active					True to attach the reader, false to detach it.
+    //----------------------------------------------------------------------------------------
+    void setReaderActive(int reader, bool active) noexcept;
+
+    //----------------------------------------------------------------------------------------
+    /// Returns the number of items that can be added to the buffer without overflowing the slowest active reader.
     //----------------------------------------------------------------------------------------
     int getFreeSpace() const noexcept;
 
     //----------------------------------------------------------------------------------------
-    /// Returns the number of items in the buffer.
+    /// Returns the number of items in the buffer that a reader hasn't read yet.
+    /// @param[in] reader					Index of the reader.
+    //----------------------------------------------------------------------------------------
+    int getNumReady(int reader = 0) const noexcept;
+
+    //----------------------------------------------------------------------------------------
+    /// Returns the number of items written since the creation of the buffer (dropped items excluded). It's never reset.
+    //----------------------------------------------------------------------------------------
+    int64 getWritePosition() const noexcept;
+
+    //----------------------------------------------------------------------------------------
+    /// Returns the position in the stream of the next item a reader will read. Should be called from the reader's thread.
+    /// @param[in] reader					Index of the reader.
+    //----------------------------------------------------------------------------------------
+    int64 getReadPosition(int reader = 0) const noexcept;
+
+    //----------------------------------------------------------------------------------------
+    /// Moves a reader to the current write position, so that the buffer appears empty to it.
+    /// Can be called while writing, but only from the reader's thread (or while it doesn't read).
+    /// @param[in] reader					Index of the reader.
     //----------------------------------------------------------------------------------------
-    int getNumReady() const noexcept;
+    void resetReader(int reader) noexcept;
 
     //----------------------------------------------------------------------------------------
-    /// Clears the buffer positions, so that it appears empty.
+    /// Clears the buffer positions of the writer and every reader, so that it appears empty.
+    /// @warning							Not thread-safe! Shouldn't be called while reading or writing.
     //----------------------------------------------------------------------------------------
     void reset() noexcept;
 
-private:
     //----------------------------------------------------------------------------------------
-    /// Wraps the information needed to perform the actual read or write operation.
-    /// Since it's a ring buffer, the requested block can span from the end of the buffer to the beginning.
-    /// So, the requested block is handled as two separate blocks.
+    /// Locates the oldest items of a reader without consuming them, so that they can be read in place.
+    /// Only the reader's thread should call it, and the items stay valid until commit() is called.
+    /// @param[in] numToRead				Number of items to locate.
+    /// @param[out] pendingRead				Location of the items, to be handed to commit().
+    /// @param[in] reader					Index of the reader.
+    /// @return								False if the requested number of items to read from the buffer is too large. True otherwise.
     //----------------------------------------------------------------------------------------
-    struct OperationResult
-    {
-        int startIndex1;	/// Index of the first part of the requested block.
-        int blockSize1;		/// Size of the first part of the requested block.
-        int startIndex2;	/// Index of the second part of the requested block (always 0).
-        int blockSize2;		/// Size of the second part of the requested block (0 if no second part).
-    };
+    bool peek(int numToRead, PendingRead& pendingRead, int reader = 0) const noexcept;
+
+    //----------------------------------------------------------------------------------------
+    /// Consumes the first items of a pending read, the others being read again by the next operation (overlap).
+    /// @param[in] pendingRead				Items located by the last peek() of the reader.
+    /// @param[in] numRead					Number of items to remove from the buffer (at most the number of peeked items).
+    /// @return								False if the items were overwritten by the writer since they were peeked (OverwriteOldest policy),
+    ///										in which case whatever was read from them should be discarded. True otherwise.
+    //----------------------------------------------------------------------------------------
+    bool commit(const PendingRead& pendingRead, int numRead) noexcept;
 
+private:
     //----------------------------------------------------------------------------------------
     /// Returns the current read or write location of a block of data within the buffer.
     /// When reading, the targeted buffer area should be the one filled with items.
@@ -77,41 +176,48 @@ private:
     //----------------------------------------------------------------------------------------
     OperationResult generateResult(int firstIndex, int lastIndex, int blockSize) const noexcept;
 
+    //----------------------------------------------------------------------------------------
+    /// Returns the index of the buffer matching a position in the stream: the tail for the write position, a head for a read position.
+    //----------------------------------------------------------------------------------------
+    int getTailIndex(int64 position) const noexcept
+    {
+        return static_cast<int>((position - m_positionOffset) % getTotalSize());
+    }
+
+    //----------------------------------------------------------------------------------------
+    /// Pushes forward the heads of the readers that don't leave enough free space, discarding their oldest items (writer only).
+    /// @param[in] writePosition			Current write position.
+    /// @param[in] numToWrite				Number of items about to be written (less than the total size).
+    //----------------------------------------------------------------------------------------
+    void makeRoom(int64 writePosition, int numToWrite) noexcept;
+
 public:
     //----------------------------------------------------------------------------------------
     /// Performs a full read operation using this abstract buffer.
     /// @param[in] numToRead	            Number of items to read from the buffer (guaranteed).
     /// @param[in] readOperation	        Actual read operation. The lambda should take an OperationResult as parameter (or auto) and return the final number of items read from the buffer.
-    /// @return								False if the requested number of items to read from the buffer is too large. True otherwise.
+    /// @param[in] reader					Index of the reader. Its cursor is the only one moved by the operation.
+    /// @param[out] position				If not null, receives the position in the stream of the first item read.
+    /// @return								False if the requested number of items to read from the buffer is too large, or if they were
+    ///										overwritten by the writer during the operation (OverwriteOldest policy). True otherwise.
     //----------------------------------------------------------------------------------------
     template<class Lambda>
-    bool read(int numToRead, Lambda readOperation)
+    bool read(int numToRead, Lambda readOperation, int reader = 0, int64* position = nullptr)
     {
-        // Relaxed, because the writer thread will never change m_head
-        const auto head = m_head.load(std::memory_order_relaxed);
-        // Acquire, because the writer thread is the one that changes m_tail
-        const auto tail = m_tail.load(std::memory_order_acquire);
-
-        // Equivalent of calling getNumReady(), but faster since the atomic accesses
-        // are already done and more optimized
-        const auto numReady = (tail >= head ? tail - head : getTotalSize() - (head - tail));
-        if (numToRead > numReady)
+        PendingRead pendingRead;
+        if (!peek(numToRead, pendingRead, reader))
             return false;
 
         // Perform the actual read operation
-        const int numRead = readOperation(generateResult(head, tail, numToRead));
+        const int numRead = readOperation(pendingRead.blocks);
 
         // Update the state of the virtual FIFO
-        jassert(numRead >= 0 && numRead <= getTotalSize());
-        auto newHead = head + numRead;
+        if (!commit(pendingRead, numRead))
+            return false;
 
-        if (newHead >= getTotalSize())
-        {
-            newHead -= getTotalSize();
-        }
+        if (position != nullptr)
+            *position = pendingRead.position;
 
-        // Release, because the writer thread may try to acquire m_head
-        m_head.store(newHead, std::memory_order_release);
         return true;
     }
 
@@ -119,36 +225,52 @@ public:
     /// Performs a full write operation using this abstract buffer.
     /// @param[in] numToWrite	            Number of items to write in the buffer (guaranteed).
     /// @param[in] writeOperation	        Actual write operation. The lambda should take an OperationResult as parameter (or auto) and return the final number of items written in the buffer.
-    /// @return								False if the requested number of items to write in the buffer is too large. True otherwise.
+    /// @return								False if the requested number of items to write in the buffer is too large (and was dropped). True otherwise.
     //----------------------------------------------------------------------------------------
     template<class Lambda>
     bool write(int numToWrite, Lambda writeOperation)
     {
-        // Relaxed, because the reader thread will never change m_tail
-        const auto tail = m_tail.load(std::memory_order_relaxed);
-        // Acquire, because the reader thread is the one that changes m_head
-        const auto head = m_head.load(std::memory_order_acquire);
-
-        // Equivalent of calling getFreeSpace(), but faster since the atomic accesses
-        // are already done and more optimized
-        const auto freeSpace = (tail >= head ? getTotalSize() - (tail - head) : head - tail) - 1;
+        // Relaxed, because the reader threads will never change m_writePosition
+        const auto writePosition = m_writePosition.load(std::memory_order_relaxed);
+        const auto tail = getTailIndex(writePosition);
+
+        // The slowest active reader holds the oldest unread item. Without any active reader, the whole buffer is free.
+        int64 slowestReadPosition = writePosition;
+        for (int i = 0; i < m_numReaders; ++i)
+        {
+            // Acquire, because the reader threads are the ones that change their state and head
+            if (!m_readers[i].active.load(std::memory_order_acquire))
+                continue;
+
+            slowestReadPosition = jmin(slowestReadPosition, m_readers[i].readPosition.load(std::memory_order_acquire));
+        }
+
+        const auto maxNumReady = static_cast<int>(writePosition - slowestReadPosition);
+        int slowestHead = getTailIndex(slowestReadPosition);
+
+        const auto freeSpace = getTotalSize() - maxNumReady - 1;
         if (numToWrite > freeSpace)
-            return false;
+        {
+            if (m_overflowPolicy.load(std::memory_order_relaxed) == OverflowPolicy::DropNewest || numToWrite > getTotalSize() - 1)
+            {
+                // Only the writer updates the counters
+                m_numDropped.store(m_numDropped.load(std::memory_order_relaxed) + static_cast<uint64>(numToWrite), std::memory_order_relaxed);
+                return false;
+            }
+
+            makeRoom(writePosition, numToWrite);
+            // The items after the new ones are all overwritten
+            slowestHead = tail;
+        }
 
         // Perform the actual write operation
-        const int numWritten = writeOperation(generateResult(tail, head, numToWrite));
+        const int numWritten = writeOperation(generateResult(tail, slowestHead, numToWrite));
 
         // Update the state of the virtual FIFO
         jassert(numWritten >= 0 && numWritten < getTotalSize());
-        auto newTail = tail + numWritten;
-
-        if (newTail >= getTotalSize())
-        {
-            newTail -= getTotalSize();
-        }
 
-        // Release, because the reader thread may try to acquire m_tail
-        m_tail.store(newTail, std::memory_order_release);
+        // Release, because the reader threads may try to acquire m_writePosition
+        m_writePosition.store(writePosition + numWritten, std::memory_order_release);
         return true;
     }
 
@@ -156,14 +278,28 @@ private:
     // Cache line size used to align head and tail properly and avoid false sharing
     static constexpr size_t CACHE_LINE_SIZE = std::hardware_destructive_interference_size;
 
-    int m_bufferSize = 0;	/// Total size of the buffer being managed.
-    
-    // Align to avoid false sharing between head and tail
-    alignas(CACHE_LINE_SIZE) std::atomic<int> m_head = 0;	/// Head / front of the virtual FIFO (used for read operations).
-    alignas(CACHE_LINE_SIZE) std::atomic<int> m_tail = 0;	/// Tail / back of the virtual FIFO (used for write operations).
+    //----------------------------------------------------------------------------------------
+    /// Read cursor of one reader, on its own cache line.
+    //----------------------------------------------------------------------------------------
+    struct alignas(CACHE_LINE_SIZE) ReadCursor
+    {
+        std::atomic<int64> readPosition { 0 };	/// Head / front of the virtual FIFO seen by the reader, as a position in the stream (used for read operations).
+        std::atomic<bool> active { false };	/// True if the reader holds back the writer.
+    };
+
+    int m_bufferSize = 0;		/// Total size of the buffer being managed.
+    const int m_numReaders;		/// Number of read cursors.
+    int64 m_positionOffset = 0;	/// Write position matching the first index of the buffer (set on reset).
+
+    // Align to avoid false sharing between the heads and the tail
+    ReadCursor m_readers[maxReaders];						/// Read cursor of each reader.
+    alignas(CACHE_LINE_SIZE) std::atomic<int64> m_writePosition { 0 }; /// Tail / back of the virtual FIFO, as a number of written items (used for write operations).
+    std::atomic<uint64> m_numDropped { 0 };					/// Number of items discarded by the writer (written by the writer only).
+    std::atomic<uint64> m_numOverwritten { 0 };				/// Number of unread items overwritten by the writer (written by the writer only).
+    std::atomic<OverflowPolicy> m_overflowPolicy { OverflowPolicy::DropNewest }; /// What the writer does when the buffer is full.
 
     // Padding to avoid adjacent allocations to the same cache line as tail
-    char m_padding[CACHE_LINE_SIZE - sizeof(decltype(m_tail))];
+    char m_padding[CACHE_LINE_SIZE - sizeof(decltype(m_writePosition))];
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AbstractRingBuffer)
 };
@@ -0,0 +1,92 @@
+//--------------------------------------------------------------------------------------------
+// Name: FrameQueue.h
+// Author: Jérémi Panneton
+// Creation date: October 16th, 2026
+//--------------------------------------------------------------------------------------------
+
+#pragma once
+
+#include "AbstractRingBuffer.h"
+#include <vector>
+
+//--------------------------------------------------------------------------------------------
+/// Single-reader single-writer lock-free FIFO of preallocated frames.
+/// Frames are written and read in place, so no allocation is performed after construction.
+//--------------------------------------------------------------------------------------------
+template<typename FrameType>
+class FrameQueue
+{
+public:
+    //----------------------------------------------------------------------------------------
+    /// Constructor.
+    /// @param[in] capacity					Maximum number of frames the queue can hold.
+    /// @param[in] prototype				Frame used to initialize (and preallocate) every slot of the queue.
+    //----------------------------------------------------------------------------------------
+    FrameQueue(int capacity, const FrameType& prototype = FrameType())
+        : m_abstractFifo(capacity + 1) // One slot is always kept free to distinguish a full queue from an empty one
+        , m_frames(static_cast<size_t>(capacity + 1), prototype)
+    {
+    }
+
+    //----------------------------------------------------------------------------------------
+    /// Adds a frame to the queue. The frame is filled in place by the write operation.
+    /// @param[in] writeOperation			Lambda taking a reference to the frame to fill (FrameType&).
+    /// @return								False if the queue is full. True otherwise.
+    //----------------------------------------------------------------------------------------
+    template<class Lambda>
+    bool push(Lambda writeOperation)
+    {
+        return m_abstractFifo.write(1, [&](const auto& result)
+        {
+            writeOperation(m_frames[result.startIndex1]);
+            return 1;
+        });
+    }
+
+    //----------------------------------------------------------------------------------------
+    /// Pops a frame from the queue. Since it's a FIFO, the oldest frame is retrieved.
+    /// The frame is only valid during the read operation, since its slot gets reused afterwards.
+    /// @param[in] readOperation			Lambda taking a const reference to the oldest frame (const FrameType&).
+    /// @return								False if the queue is empty. True otherwise.
+    //----------------------------------------------------------------------------------------
+    template<class Lambda>
+    bool pop(Lambda readOperation)
+    {
+        return m_abstractFifo.read(1, [&](const auto& result)
+        {
+            readOperation(static_cast<const FrameType&>(m_frames[result.startIndex1]));
+            return 1;
+        });
+    }
+
+    //----------------------------------------------------------------------------------------
+    /// Returns the number of frames ready to be popped.
+    //----------------------------------------------------------------------------------------
+    int getNumReady() const noexcept
+    {
+        return m_abstractFifo.getNumReady();
+    }
+
+    //----------------------------------------------------------------------------------------
+    /// Returns the number of frames that can be pushed without overflowing.
+    //----------------------------------------------------------------------------------------
+    int getFreeSpace() const noexcept
+    {
+        return m_abstractFifo.getFreeSpace();
+    }
+
+    //----------------------------------------------------------------------------------------
+    /// Clears the queue. No reallocation is being done, but the logical size of the queue is resetted.
+    /// @warning							Not thread-safe! Shouldn't be called while pushing or popping.
+    //----------------------------------------------------------------------------------------
+    void clear() noexcept
+    {
+        m_abstractFifo.reset();
+    }
+
+private:
+    AbstractRingBuffer m_abstractFifo;
+    std::vector<FrameType> m_frames;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(FrameQueue)
+};
\ No newline at end of file
@@ -7,6 +7,8 @@
 #pragma once
 
 #include "NormalizedRange.h"
+#include <algorithm>
+#include <cmath>
 #include <vector>
 
 //--------------------------------------------------------------------------------------------
@@ -21,8 +23,11 @@ class FrequencyAxis
 public:
     enum class Distribution
     {
-        Linear,
-        Logarithmic
+        Linear,			/// Evenly spaced in Hz.
+        Logarithmic,	/// Evenly spaced in octaves.
+        Mel,			/// Evenly spaced on the mel scale (pitch perception).
+        Bark,			/// Evenly spaced on the Bark scale (critical bands, Traunmüller's formula).
+        ERB				/// Evenly spaced on the ERB-rate scale (auditory filters, Glasberg and Moore's formula).
     };
 
     //----------------------------------------------------------------------------------------
@@ -52,6 +57,22 @@ public:
         }
     }
 
+    //----------------------------------------------------------------------------------------
+    /// Returns how the frequencies are distributed over the axis.
+    //----------------------------------------------------------------------------------------
+    Distribution getDistribution() const noexcept
+    {
+        return m_distribution;
+    }
+
+    //----------------------------------------------------------------------------------------
+    /// Returns true if the distribution follows a perceptual scale (mel, Bark or ERB).
+    //----------------------------------------------------------------------------------------
+    bool isPerceptual() const noexcept
+    {
+        return m_distribution == Distribution::Mel || m_distribution == Distribution::Bark || m_distribution == Distribution::ERB;
+    }
+
     //----------------------------------------------------------------------------------------
     /// Sets the resolution (or size) of the axis.
     /// @param[in] resolution				Number of frequencies the axis should contain.
@@ -96,6 +117,22 @@ public:
         return m_frequencyMap[index];
     }
 
+    //----------------------------------------------------------------------------------------
+    /// Returns the index of the mapped frequency closest to the specified frequency (binary search).
+    /// @param[in] frequency				Frequency to look for.
+    /// @return								Index of the closest frequency, or -1 if the frequency is out of the axis range.
+    //----------------------------------------------------------------------------------------
+    int getClosestIndex(ValueType frequency) const noexcept
+    {
+        if (!(frequency >= m_frequencyMap.front() && frequency <= m_frequencyMap.back()))
+            return -1;
+
+        // First mapped frequency above the specified one (the mapping is increasing)
+        const auto next = std::lower_bound(m_frequencyMap.begin(), m_frequencyMap.end(), frequency);
+        const int index = static_cast<int>(next - m_frequencyMap.begin());
+        return (index > 0 && frequency - m_frequencyMap[index - 1] < *next - frequency) ? index - 1 : index;
+    }
+
 private:
     //----------------------------------------------------------------------------------------
     /// Maps the frequencies defined in the range according to the current parameters.
@@ -111,7 +148,7 @@ private:
         {
             for (size_t i = 0; i < frequencyCount; ++i)
             {
-                m_frequencyMap[i] = i / ValueType(frequencyCount - 1);
+                m_frequencyMap[i] = m_frequencyRange.getLinearValue(i / ValueType(frequencyCount - 1));
             }
 
             break;
@@ -125,6 +162,62 @@ private:
 
             break;
         }
+        case Distribution::Mel:
+        case Distribution::Bark:
+        case Distribution::ERB:
+        {
+            // Evenly spaced on the perceptual scale
+            const ValueType minWarped = warp(m_distribution, m_frequencyRange.getMin());
+            const ValueType maxWarped = warp(m_distribution, m_frequencyRange.getMax());
+            for (size_t i = 0; i < frequencyCount; ++i)
+            {
+                m_frequencyMap[i] = unwarp(m_distribution, minWarped + (maxWarped - minWarped) * i / ValueType(frequencyCount - 1));
+            }
+
+            break;
+        }
+        }
+    }
+
+    //----------------------------------------------------------------------------------------
+    /// Converts a frequency to a perceptual scale.
+    /// @param[in] distribution				Perceptual distribution (mel, Bark or ERB).
+    /// @param[in] frequency				Frequency in Hz.
+    /// @return								Position on the scale (mels, Barks or ERB number).
+    //----------------------------------------------------------------------------------------
+    static ValueType warp(Distribution distribution, ValueType frequency)
+    {
+        switch (distribution)
+        {
+        case Distribution::Mel:
+            return ValueType(2595.0 * std::log10(1.0 + frequency / 700.0));
+        case Distribution::Bark:
+            return ValueType(26.81 * frequency / (1960.0 + frequency) - 0.53);
+        case Distribution::ERB:
+            return ValueType(21.4 * std::log10(1.0 + 0.00437 * frequency));
+        default:
+            return frequency;
+        }
+    }
+
+    //----------------------------------------------------------------------------------------
+    /// Converts a position on a perceptual scale back to a frequency.
+    /// @param[in] distribution				Perceptual distribution (mel, Bark or ERB).
+    /// @param[in] value					Position on the scale (mels, Barks or ERB number).
+    /// @return								Frequency in Hz.
+    //----------------------------------------------------------------------------------------
+    static ValueType unwarp(Distribution distribution, ValueType value)
+    {
+        switch (distribution)
+        {
+        case Distribution::Mel:
+            return ValueType(700.0 * (std::pow(10.0, value / 2595.0) - 1.0));
+        case Distribution::Bark:
+            return ValueType(1960.0 * (value + 0.53) / (26.28 - value));
+        case Distribution::ERB:
+            return ValueType((std::pow(10.0, value / 21.4) - 1.0) / 0.00437);
+        default:
+            return value;
         }
     }
 
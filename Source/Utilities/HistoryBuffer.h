@@ -0,0 +1,145 @@
+//--------------------------------------------------------------------------------------------
+// Name: HistoryBuffer.h
+// Author: Jérémi Panneton
+// Creation date: October 16th, 2026
+//--------------------------------------------------------------------------------------------
+
+#pragma once
+
+#include "JuceHeader.h"
+#include <atomic>
+#include <memory>
+#include <type_traits>
+
+//--------------------------------------------------------------------------------------------
+/// Single-writer multiple-reader lock-free history of the latest values.
+/// Unlike a FIFO, reading doesn't consume anything: any number of threads can read the newest values at any time,
+/// and the writer never waits for them (the oldest values are simply overwritten).
+/// Each slot is guarded by a sequence number (seqlock), so a reader retries a slot that was written while being copied.
+//--------------------------------------------------------------------------------------------
+template<typename T>
+class HistoryBuffer
+{
+public:
+    static_assert(std::is_trivially_copyable<T>::value, "Values are copied while they may be written, so they should be trivially copyable");
+
+    //----------------------------------------------------------------------------------------
+    /// Constructor.
+    /// @param[in] capacity					Number of values kept in the history.
+    //----------------------------------------------------------------------------------------
+    HistoryBuffer(int capacity)
+        : m_capacity(capacity)
+        , m_slots(new Slot[static_cast<size_t>(capacity)])
+    {
+        jassert(capacity > 0);
+    }
+
+    //----------------------------------------------------------------------------------------
+    /// Adds a value to the history, overwriting the oldest one if the history is full. Should only be called from a single writer thread.
+    /// @param[in] value					Value to add.
+    //----------------------------------------------------------------------------------------
+    void push(const T& value) noexcept
+    {
+        const uint32 index = m_numWritten.load(std::memory_order_relaxed);
+        Slot& slot = m_slots[index % static_cast<uint32>(m_capacity)];
+
+        // An odd sequence number tells the readers that the slot is being written
+        const uint32 sequence = slot.sequence.load(std::memory_order_relaxed);
+        slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        slot.value = value;
+
+        slot.sequence.store(sequence + 2, std::memory_order_release);
+        m_numWritten.store(index + 1, std::memory_order_release);
+    }
+
+    //----------------------------------------------------------------------------------------
+    /// Copies the newest values of the history, from the oldest to the newest. Can be called from any thread.
+    /// @param[out] values					Buffer in which to copy the values. Its size should be at least maxValues.
+    /// @param[in] maxValues				Maximum number of values to copy.
+    /// @return								Number of values copied (less than maxValues if the history doesn't hold that many values yet).
+    //----------------------------------------------------------------------------------------
+    int read(T* values, int maxValues) const noexcept
+    {
+        const uint32 numWritten = m_numWritten.load(std::memory_order_acquire);
+        const int numValues = static_cast<int>(jmin(numWritten, static_cast<uint32>(jmin(maxValues, m_capacity))));
+        int numRead = 0;
+
+        for (int i = 0; i < numValues; ++i)
+        {
+            const uint32 index = numWritten - static_cast<uint32>(numValues - i);
+
+            // Values overwritten since the read started are skipped, so the copied values stay in order
+            if (readSlot(index, values[numRead]))
+                ++numRead;
+        }
+
+        return numRead;
+    }
+
+    //----------------------------------------------------------------------------------------
+    /// Copies the newest value of the history. Can be called from any thread.
+    /// @param[out] value					Newest value.
+    /// @return								False if the history is empty. True otherwise.
+    //----------------------------------------------------------------------------------------
+    bool readLatest(T& value) const noexcept
+    {
+        return read(&value, 1) == 1;
+    }
+
+    //----------------------------------------------------------------------------------------
+    /// Returns the total number of values written since the construction (can be used to detect new values).
+    //----------------------------------------------------------------------------------------
+    uint32 getNumWritten() const noexcept
+    {
+        return m_numWritten.load(std::memory_order_acquire);
+    }
+
+    //----------------------------------------------------------------------------------------
+    /// Returns the number of values kept in the history.
+    //----------------------------------------------------------------------------------------
+    int getCapacity() const noexcept
+    {
+        return m_capacity;
+    }
+
+private:
+    struct Slot
+    {
+        std::atomic<uint32> sequence { 0 };	/// Twice the number of times the slot was written (odd while being written).
+        T value {};							/// Stored value.
+    };
+
+    //----------------------------------------------------------------------------------------
+    /// Copies the value written at a given index, retrying while it's being written.
+    /// @param[in] index					Index of the value (number of values written before it).
+    /// @param[out] value					Copied value.
+    /// @return								False if the value has already been overwritten by a newer one. True otherwise.
+    //----------------------------------------------------------------------------------------
+    bool readSlot(uint32 index, T& value) const noexcept
+    {
+        const Slot& slot = m_slots[index % static_cast<uint32>(m_capacity)];
+        // Sequence number of the slot once the value at this index is written
+        const uint32 expectedSequence = 2 * (index / static_cast<uint32>(m_capacity) + 1);
+
+        for (;;)
+        {
+            const uint32 sequenceBefore = slot.sequence.load(std::memory_order_acquire);
+            if (sequenceBefore > expectedSequence)
+                return false;
+
+            value = slot.value;
+            std::atomic_thread_fence(std::memory_order_acquire);
+
+            if (slot.sequence.load(std::memory_order_relaxed) == sequenceBefore && sequenceBefore == expectedSequence)
+                return true;
+        }
+    }
+
+    const int m_capacity;						/// Number of values kept in the history.
+    std::unique_ptr<Slot[]> m_slots;			/// Slots of the history, used circularly.
+    std::atomic<uint32> m_numWritten { 0 };		/// Number of values written since the construction.
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(HistoryBuffer)
+};
\ No newline at end of file
@@ -9,76 +9,304 @@
 #include "AbstractRingBuffer.h"
 
 //--------------------------------------------------------------------------------------------
-/// Single-reader single-writer lock-free FIFO.
+/// Single-writer lock-free FIFO, broadcast to one or several readers.
+/// Each block is copied once by the writer, whatever the number of readers: every reader keeps its own read cursor
+/// over the same storage, and the slowest active one defines the free space.
+/// The channel count can be fixed at compile time (Channels > 0), so that every copy loop over the channels gets unrolled.
+/// The channels are stored one after the other (planar), which lets the readers process them in place (see peekSamples()).
 //--------------------------------------------------------------------------------------------
-template<typename T>
+template<typename T, int Channels = 0>
 class RingBuffer
 {
 public:
     using ValueType = T;
 
+    //----------------------------------------------------------------------------------------
+    /// Audio data read in place from the queue. Since the queue wraps around, the data of each channel
+    /// lies in one or two contiguous regions: the second one continues the first one (and is empty if there's no wrap).
+    //----------------------------------------------------------------------------------------
+    struct ReadView
+    {
+        //------------------------------------------------------------------------------------
+        /// Returns the first region of a channel (getSize1() samples).
+        //------------------------------------------------------------------------------------
+        const ValueType* getRegion1(int channel) const noexcept
+        {
+            return buffer->getReadPointer(channel, pendingRead.blocks.startIndex1);
+        }
+
+        //------------------------------------------------------------------------------------
+        /// Returns the second region of a channel (getSize2() samples).
+        //------------------------------------------------------------------------------------
+        const ValueType* getRegion2(int channel) const noexcept
+        {
+            return buffer->getReadPointer(channel, pendingRead.blocks.startIndex2);
+        }
+
+        int getSize1() const noexcept { return pendingRead.blocks.blockSize1; }
+        int getSize2() const noexcept { return pendingRead.blocks.blockSize2; }
+
+        //------------------------------------------------------------------------------------
+        /// Returns the position of the first sample in the stream (number of samples written before it).
+        //------------------------------------------------------------------------------------
+        int64 getStartPosition() const noexcept { return pendingRead.position; }
+
+        const AudioBuffer<ValueType>* buffer = nullptr;	/// Storage of the ring buffer.
+        AbstractRingBuffer::PendingRead pendingRead;	/// Location of the data in the storage.
+    };
+
     //----------------------------------------------------------------------------------------
     /// Constructor.
-    /// @param[in] channelCount				Number of buffers (one for each channel).
+    /// @param[in] channelCount				Number of buffers (one for each channel). Should match Channels if it's fixed.
     /// @param[in] bufferSize				Total size of one buffer.
+    /// @param[in] numReaders				Number of readers (at most AbstractRingBuffer::maxReaders). Only the first one is active at first.
+    //----------------------------------------------------------------------------------------
+    RingBuffer(int channelCount, int bufferSize, int numReaders = 1)
+        : m_abstractFifo(bufferSize, numReaders)
+        , m_audioBuffer(Channels > 0 ? Channels : channelCount, bufferSize)
+    {
+        jassert(Channels == 0 || channelCount == Channels);
+    }
+
     //----------------------------------------------------------------------------------------
-    RingBuffer(int channelCount, int bufferSize)
-        : m_audioBuffer(channelCount, bufferSize)
-        , m_abstractFifo(bufferSize)
+    /// Returns the number of channels (a constant if the channel count is fixed at compile time).
+    //----------------------------------------------------------------------------------------
+    int getNumChannels() const noexcept
     {
+        return Channels > 0 ? Channels : m_audioBuffer.getNumChannels();
     }
 
     //----------------------------------------------------------------------------------------
-    /// Adds audio data to the queue.
+    /// Adds audio data to the queue. If it doesn't fit, it's either dropped or it overwrites the oldest data, according to the overflow policy.
     /// @param[in] buffer					Buffer containing audio data.
-    /// @return								False if the requested number of items to write in the buffer is too large. True otherwise.
+    /// @param[in] timestamp				Time at which the audio was received, in milliseconds on the Time::getMillisecondCounterHiRes() clock
+    ///										(a host timestamp converted to this clock, for instance). If 0, the current time is used.
+    /// @return								False if the requested number of items to write in the buffer is too large (and was dropped). True otherwise.
+    //----------------------------------------------------------------------------------------
+    bool writeSamples(const AudioBuffer<ValueType>& buffer, double timestamp = 0.0)
+    {
+        jassert(buffer.getNumChannels() == getNumChannels());
+        return writeSamples(buffer.getArrayOfReadPointers(), buffer.getNumSamples(), timestamp);
+    }
+
+    //----------------------------------------------------------------------------------------
+    /// Adds audio data to the queue, straight from the channel pointers (cheapest for the small blocks of the audio thread).
+    /// Every written sample gets the next position of the stream (see getWritePosition()).
+    /// @param[in] channelData				Audio data (one buffer of numSamples samples for each channel of the queue).
+    /// @param[in] numSamples				Number of samples to add.
+    /// @param[in] timestamp				Time at which the audio was received, in milliseconds on the Time::getMillisecondCounterHiRes() clock.
+    ///										If 0, the current time is used.
+    /// @return								False if the requested number of items to write in the buffer is too large (and was dropped). True otherwise.
     //----------------------------------------------------------------------------------------
-    bool writeSamples(const AudioBuffer<ValueType>& buffer)
+    bool writeSamples(const ValueType* const* channelData, int numSamples, double timestamp = 0.0)
     {
-        jassert(buffer.getNumChannels() == m_audioBuffer.getNumChannels());
-        return m_abstractFifo.write(buffer.getNumSamples(), [&](const auto& result)
+        const bool written = m_abstractFifo.write(numSamples, [&](const auto& result)
         {
-            for (int i = 0; i < buffer.getNumChannels(); ++i)
+            for (int i = 0; i < getNumChannels(); ++i)
             {
-                if (result.blockSize1 > 0)
-                {
-                    m_audioBuffer.copyFrom(i, result.startIndex1, buffer.getReadPointer(i), result.blockSize1);
-                }
-
-                if (result.blockSize2 > 0)
-                {
-                    m_audioBuffer.copyFrom(i, result.startIndex2, buffer.getReadPointer(i) + result.blockSize1, result.blockSize2);
-                }
+                ValueType* channel = m_audioBuffer.getWritePointer(i);
+                FloatVectorOperations::copy(channel + result.startIndex1, channelData[i], result.blockSize1);
+                FloatVectorOperations::copy(channel + result.startIndex2, channelData[i] + result.blockSize1, result.blockSize2);
             }
             return result.blockSize1 + result.blockSize2;
         });
+
+        if (written)
+            m_lastWriteTime.store(timestamp > 0.0 ? timestamp : Time::getMillisecondCounterHiRes(), std::memory_order_release);
+
+        return written;
     }
 
     //----------------------------------------------------------------------------------------
     /// Pops audio data from the queue. Since it's a FIFO, the oldest data is retrieved.
     /// @param[out] buffer					Buffer in which to store the audio data.
     /// @param[in] overlapRatio				Ratio of data to keep in the queue after being read. If 0.0 (min value), all the requested data is read and removed from the queue. If 1.0 (max value), all the requested data is read and none is removed from the queue.
-    /// @return								False if the requested number of items to read from the buffer is too large. True otherwise.
+    /// @param[in] reader					Index of the reader.
+    /// @return								False if the requested number of items to read from the buffer is too large, or if they were overwritten while being read. True otherwise.
     //----------------------------------------------------------------------------------------
-    bool readSamples(AudioBuffer<ValueType>& buffer, double overlapRatio = 0.0)
+    bool readSamples(AudioBuffer<ValueType>& buffer, double overlapRatio = 0.0, int reader = 0)
     {
-        jassert(buffer.getNumChannels() == m_audioBuffer.getNumChannels());
+        jassert(buffer.getNumChannels() == getNumChannels());
         return m_abstractFifo.read(buffer.getNumSamples(), [&](const auto& result)
         {
-            for (int i = 0; i < buffer.getNumChannels(); ++i)
-            {
-                if (result.blockSize1 > 0)
-                {
-                    buffer.copyFrom(i, 0, m_audioBuffer.getReadPointer(i, result.startIndex1), result.blockSize1);
-                }
-
-                if (result.blockSize2 > 0)
-                {
-                    buffer.copyFrom(i, result.blockSize1, m_audioBuffer.getReadPointer(i, result.startIndex2), result.blockSize2);
-                }
-            }
+            copyBlocks(result, buffer);
             return static_cast<int>((result.blockSize1 + result.blockSize2) * (1.0 - overlapRatio));
-        });
+        }, reader);
+    }
+
+    //----------------------------------------------------------------------------------------
+    /// Pops audio data from the queue, but only removes the first hopSize samples. Since it's a FIFO, the oldest data is retrieved.
+    /// This is the sample-accurate equivalent of readSamples(buffer, overlapRatio) used for STFT framing.
+    /// @param[out] buffer					Buffer in which to store the audio data. Its size should be at least numToRead.
+    /// @param[in] numToRead				Number of samples to read from the queue (frame size).
+    /// @param[in] hopSize					Number of samples to remove from the queue after being read (between 0 and numToRead).
+    /// @param[in] reader					Index of the reader.
+    /// @param[out] startPosition			If not null, receives the position in the stream of the first sample read.
+    /// @return								False if the requested number of items to read from the buffer is too large, or if they were overwritten while being read. True otherwise.
+    //----------------------------------------------------------------------------------------
+    bool readSamples(AudioBuffer<ValueType>& buffer, int numToRead, int hopSize, int reader = 0, int64* startPosition = nullptr)
+    {
+        jassert(buffer.getNumChannels() == getNumChannels());
+        jassert(numToRead <= buffer.getNumSamples());
+        jassert(hopSize >= 0 && hopSize <= numToRead);
+        return m_abstractFifo.read(numToRead, [&](const auto& result)
+        {
+            copyBlocks(result, buffer);
+            return hopSize;
+        }, reader, startPosition);
+    }
+
+    //----------------------------------------------------------------------------------------
+    /// Pops audio data from the queue and derives a single channel from it on the fly (mono, mid or side for instance):
+    /// output = sum of gains[i] * channel i. Only the first hopSize samples are removed, like readSamples().
+    /// @param[out] output					Derived channel (numToRead samples).
+    /// @param[in] gains					Gain applied to each channel. The channels with a null gain are skipped (except the first one).
+    /// @param[in] numToRead				Number of samples to read from the queue (frame size).
+    /// @param[in] hopSize					Number of samples to remove from the queue after being read (between 0 and numToRead).
+    /// @param[in] reader					Index of the reader.
+    /// @param[out] startPosition			If not null, receives the position in the stream of the first sample read.
+    /// @return								False if the requested number of items to read from the buffer is too large, or if they were overwritten while being read. True otherwise.
+    //----------------------------------------------------------------------------------------
+    bool readMixedSamples(ValueType* output, const ValueType* gains, int numToRead, int hopSize, int reader = 0, int64* startPosition = nullptr)
+    {
+        jassert(hopSize >= 0 && hopSize <= numToRead);
+        return m_abstractFifo.read(numToRead, [&](const auto& result)
+        {
+            mixBlock(output, result.startIndex1, result.blockSize1, gains);
+            mixBlock(output + result.blockSize1, result.startIndex2, result.blockSize2, gains);
+            return hopSize;
+        }, reader, startPosition);
+    }
+
+    //----------------------------------------------------------------------------------------
+    /// Gives access to the oldest audio data without copying or removing it, so that it can be processed in place.
+    /// The data stays in the queue until commitRead() is called, which should follow before the next read of the same reader.
+    /// @param[in] numToRead				Number of samples to access.
+    /// @param[out] view					Regions holding the samples of each channel.
+    /// @param[in] reader					Index of the reader.
+    /// @return								False if the requested number of items to read from the buffer is too large. True otherwise.
+    //----------------------------------------------------------------------------------------
+    bool peekSamples(int numToRead, ReadView& view, int reader = 0) const noexcept
+    {
+        view.buffer = &m_audioBuffer;
+        return m_abstractFifo.peek(numToRead, view.pendingRead, reader);
+    }
+
+    //----------------------------------------------------------------------------------------
+    /// Removes the first samples of a view from the queue. The remaining ones are kept for the next read (overlap).
+    /// @param[in] view						View returned by the last peekSamples() call of the reader.
+    /// @param[in] numToRemove				Number of samples to remove from the queue (at most the size of the view).
+    /// @return								False if the samples were overwritten while being processed (their results should be discarded). True otherwise.
+    //----------------------------------------------------------------------------------------
+    bool commitRead(const ReadView& view, int numToRemove) noexcept
+    {
+        jassert(view.buffer == &m_audioBuffer);
+        return m_abstractFifo.commit(view.pendingRead, numToRemove);
+    }
+
+    //----------------------------------------------------------------------------------------
+    /// Removes the oldest audio data from the queue without reading it.
+    /// @param[in] numToSkip				Number of samples to remove from the queue.
+    /// @param[in] reader					Index of the reader.
+    /// @return								False if the requested number of items to skip is too large. True otherwise.
+    //----------------------------------------------------------------------------------------
+    bool skipSamples(int numToSkip, int reader = 0)
+    {
+        return m_abstractFifo.read(numToSkip, [&](const auto& result)
+        {
+            return result.blockSize1 + result.blockSize2;
+        }, reader);
+    }
+
+    //----------------------------------------------------------------------------------------
+    /// Returns the number of samples ready to be read.
+    /// @param[in] reader					Index of the reader.
+    //----------------------------------------------------------------------------------------
+    int getNumReady(int reader = 0) const noexcept
+    {
+        return m_abstractFifo.getNumReady(reader);
+    }
+
+    //----------------------------------------------------------------------------------------
+    /// Returns the number of samples written since the creation of the queue, which is the position of the next one in the stream.
+    /// Can be called from any thread.
+    //----------------------------------------------------------------------------------------
+    int64 getWritePosition() const noexcept
+    {
+        return m_abstractFifo.getWritePosition();
+    }
+
+    //----------------------------------------------------------------------------------------
+    /// Returns the position in the stream of the next sample a reader will read. Should be called from the reader's thread.
+    /// @param[in] reader					Index of the reader.
+    //----------------------------------------------------------------------------------------
+    int64 getReadPosition(int reader = 0) const noexcept
+    {
+        return m_abstractFifo.getReadPosition(reader);
+    }
+
+    //----------------------------------------------------------------------------------------
+    /// Returns the timestamp of the latest write (0 before the first one), in milliseconds on the Time::getMillisecondCounterHiRes() clock.
+    /// Can be called from any thread.
+    //----------------------------------------------------------------------------------------
+    double getLastWriteTime() const noexcept
+    {
+        return m_lastWriteTime.load(std::memory_order_acquire);
+    }
+
+    //----------------------------------------------------------------------------------------
+    /// Returns the number of readers.
+    //----------------------------------------------------------------------------------------
+    int getNumReaders() const noexcept
+    {
+        return m_abstractFifo.getNumReaders();
+    }
+
+    //----------------------------------------------------------------------------------------
+    /// Attaches or detaches a reader. An inactive reader doesn't hold back the writer anymore.
+    /// Once activated, the reader starts with an empty queue. Should be called from the reader's thread (or while it doesn't read).
+    /// @param[in] reader					Index of the reader.
+    /// @param[in] active					True to attach the reader, false to detach it.
+    //----------------------------------------------------------------------------------------
+    void setReaderActive(int reader, bool active) noexcept
+    {
+        m_abstractFifo.setReaderActive(reader, active);
+    }
+
+    //----------------------------------------------------------------------------------------
+    /// Clears the queue of a single reader, without affecting the writer or the other readers.
+    /// Should be called from the reader's thread (or while it doesn't read).
+    /// @param[in] reader					Index of the reader.
+    //----------------------------------------------------------------------------------------
+    void clearReader(int reader) noexcept
+    {
+        m_abstractFifo.resetReader(reader);
+    }
+
+    //----------------------------------------------------------------------------------------
+    /// Sets what the writer does with samples that don't fit in the queue. Can be called from any thread.
+    /// OverwriteOldest suits visualization: the readers always get the latest audio, even if they fall behind.
+    /// @param[in] policy					Overflow policy.
+    //----------------------------------------------------------------------------------------
+    void setOverflowPolicy(AbstractRingBuffer::OverflowPolicy policy) noexcept
+    {
+        m_abstractFifo.setOverflowPolicy(policy);
+    }
+
+    //----------------------------------------------------------------------------------------
+    /// Returns the total number of samples (per channel) discarded by the writer. Can be called from any thread.
+    //----------------------------------------------------------------------------------------
+    uint64 getNumDropped() const noexcept
+    {
+        return m_abstractFifo.getNumDropped();
+    }
+
+    //----------------------------------------------------------------------------------------
+    /// Returns the total number of unread samples (per channel) overwritten by the writer. Can be called from any thread.
+    //----------------------------------------------------------------------------------------
+    uint64 getNumOverwritten() const noexcept
+    {
+        return m_abstractFifo.getNumOverwritten();
     }
 
     //----------------------------------------------------------------------------------------
@@ -99,7 +327,8 @@ public:
     }
 
     //----------------------------------------------------------------------------------------
-    /// Clears the queue. No reallocation is being done, but the logical size of the queue is resetted.
+    /// Clears the queue of every reader. No reallocation is being done, but the logical size of the queue is resetted.
+    /// @warning							Not thread-safe! Shouldn't be called while reading or writing.
     //----------------------------------------------------------------------------------------
     void clear() noexcept
     {
@@ -107,8 +336,40 @@ public:
     }
 
 private:
+    //----------------------------------------------------------------------------------------
+    /// Copies the blocks of a read operation to the beginning of a buffer, channel by channel.
+    //----------------------------------------------------------------------------------------
+    void copyBlocks(const AbstractRingBuffer::OperationResult& result, AudioBuffer<ValueType>& buffer) const noexcept
+    {
+        for (int i = 0; i < getNumChannels(); ++i)
+        {
+            ValueType* output = buffer.getWritePointer(i);
+            FloatVectorOperations::copy(output, m_audioBuffer.getReadPointer(i, result.startIndex1), result.blockSize1);
+            FloatVectorOperations::copy(output + result.blockSize1, m_audioBuffer.getReadPointer(i, result.startIndex2), result.blockSize2);
+        }
+    }
+
+    //----------------------------------------------------------------------------------------
+    /// Sums a block of every channel, weighted by their gain.
+    //----------------------------------------------------------------------------------------
+    void mixBlock(ValueType* output, int startIndex, int numSamples, const ValueType* gains) const noexcept
+    {
+        FloatVectorOperations::copyWithMultiply(output, m_audioBuffer.getReadPointer(0, startIndex), gains[0], numSamples);
+        for (int i = 1; i < getNumChannels(); ++i)
+        {
+            if (gains[i] != ValueType())
+                FloatVectorOperations::addWithMultiply(output, m_audioBuffer.getReadPointer(i, startIndex), gains[i], numSamples);
+        }
+    }
+
     AbstractRingBuffer m_abstractFifo;
     AudioBuffer<ValueType> m_audioBuffer;
+    std::atomic<double> m_lastWriteTime { 0.0 };	/// Timestamp of the latest write in milliseconds.
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(RingBuffer)
-};
\ No newline at end of file
+};
+
+//--------------------------------------------------------------------------------------------
+/// Stereo stream of the host, shared by the analyzers of every visualizer.
+//--------------------------------------------------------------------------------------------
+using StereoRingBuffer = RingBuffer<float, 2>;
\ No newline at end of file
@@ -5,117 +5,233 @@
 //--------------------------------------------------------------------------------------------
 
 #include "Spectrogram.h"
-#include "DSP/Filters.h"
 #include "Utilities/ColorGradients.h"
+#include <limits>
 #include <numeric>
 
-Spectrogram::Spectrogram(double sampleRate, int outputResolution, StatusBar& statusBar)
-    : OpenGLComponent(fftSize, sampleRate, false)
+Spectrogram::Spectrogram(StereoRingBuffer& ringBuffer, int ringReader, double sampleRate, int outputResolution, StatusBar& statusBar)
+    : OpenGLComponent(ringBuffer, ringReader, SpectrumAnalyzer::maxFftSize, sampleRate, false)
     , m_statusBar(statusBar)
-    , m_frequencyAxis(outputResolution, 20.0f, static_cast<float>(sampleRate) / 2) // Nyquist frequency
+    , m_analyzer(m_ringBuffer, m_ringReader, m_readBuffer, sampleRate, outputResolution)
+    , m_resolution(m_analyzer.getResolution())
     , m_colorMap(64)
-    , m_forwardFFT(fftOrder)
-    , m_window(fftSize, dsp::WindowingFunction<float>::hann)
-    , m_fftData(2 * fftSize, true)
-    , m_visuData(outputResolution, true)
-    , m_averager(5, fftBins)
+    , m_columnLevels(outputResolution)
+    , m_partialPositions(SpectrumAnalyzer::maxChannels * PartialTracks::maxTracks)
+    , m_frames(maxFramesPerUpdate, SpectralFrame(outputResolution, SpectrumAnalyzer::maxChannels))
 {
-    m_averager.clear();
-
     // Default colormap
     m_colorMap.setGradient(ColorGradients::getDefaultGradient());
 }
 
 Spectrogram::~Spectrogram()
 {
+    // Stop analysis before the ring buffer gets cleared
+    m_analyzer.stop();
     // Turn off OpenGL
     shutdownOpenGL();
 }
 
+void Spectrogram::start() noexcept
+{
+    // The ring buffer must not be cleared while it's being read
+    m_analyzer.stop();
+    OpenGLComponent::start();
+    m_analyzer.start();
+}
+
+void Spectrogram::stop() noexcept
+{
+    m_analyzer.stop();
+    OpenGLComponent::stop();
+}
+
 void Spectrogram::setMaxFrequency(float frequency, const ColourGradient& gradient)
 {
     m_colorMap.setGradient(gradient);
-    m_frequencyAxis.setMaxFrequency(frequency);
+    m_analyzer.setMaxFrequency(frequency);
 }
 
 void Spectrogram::setAdaptiveLevel(bool enabled)
 {
-    m_adaptativeLevel = enabled;
+    m_analyzer.setAdaptiveLevel(enabled);
 }
 
 void Spectrogram::setClipLevel(bool enabled)
 {
-    m_clipLevel = enabled;
+    m_analyzer.setClipLevel(enabled);
+}
+
+void Spectrogram::setHopSize(int hopSize)
+{
+    m_analyzer.setHopSize(hopSize);
+}
+
+void Spectrogram::setFftOrder(int order)
+{
+    m_analyzer.setFftOrder(order);
+}
+
+void Spectrogram::setChannelMode(SpectrumAnalyzer::ChannelMode mode)
+{
+    m_analyzer.setChannelMode(mode);
+}
+
+void Spectrogram::setTransformMode(SpectrumAnalyzer::TransformMode mode)
+{
+    m_analyzer.setTransformMode(mode);
+}
+
+void Spectrogram::setFrequencyDistribution(FrequencyAxis<float>::Distribution distribution)
+{
+    m_analyzer.setFrequencyDistribution(distribution);
+}
+
+void Spectrogram::setAveraging(const SpectralAverager::Settings& settings)
+{
+    m_analyzer.setAveraging(settings);
+}
+
+void Spectrogram::setWindow(SpectrumAnalyzer::WindowType type, float kaiserBeta)
+{
+    m_analyzer.setWindow(type, kaiserBeta);
+}
+
+void Spectrogram::setNoiseLevelCorrection(bool enabled)
+{
+    m_analyzer.setNoiseLevelCorrection(enabled);
+}
+
+void Spectrogram::setPartialTracking(bool enabled)
+{
+    m_analyzer.setPartialTracking(enabled);
+}
+
+void Spectrogram::setLatencyPolicy(SpectrumAnalyzer::LatencyPolicy policy, int maxFrames, double timeBudget)
+{
+    m_analyzer.setLatencyPolicy(policy, maxFrames, timeBudget);
+}
+
+const HistoryBuffer<SpectrumAnalyzer::FeatureSnapshot>& Spectrogram::getFeatureHistory() const noexcept
+{
+    return m_analyzer.getFeatureHistory();
 }
 
 //==========================================================================
 // OpenGL Callbacks
-bool Spectrogram::updateData()
-{
-    // Copy data from ring buffer into FFT
-    m_ringBuffer.readSamples(m_readBuffer, 0.5);
-    
-    // Zero Out FFT for next use
-    zeromem(m_fftData, sizeof(GLfloat) * 2 * fftSize);
-    FloatVectorOperations::clear(m_fftData, getReadSize());
-
-    /** Future Feature:
-        Instead of summing channels below, keep the channels separate and
-        lay out the spectrum so you can see the left and right channels
-        individually on either half of the spectrum.
-     */
-     // Sum channels together
-     // Should be average
-    for (int i = 0; i < 2; ++i)
+int Spectrogram::updateData()
+{
+    int numFrames = 0;
+
+    // Retrieve every frame finished by the analysis thread since the last update.
+    // The remaining frames (if any) will be retrieved on the next update.
+    while (numFrames < maxFramesPerUpdate && m_analyzer.popFrame(m_frames[numFrames]))
     {
-        FloatVectorOperations::add(m_fftData, m_readBuffer.getReadPointer(i), getReadSize());
+        ++numFrames;
     }
 
-    // Apply window to avoid any spectral leakage
-    m_window.multiplyWithWindowingTable(m_fftData, fftSize);
-    // Perform FFT
-    m_forwardFFT.performFrequencyOnlyForwardTransform(m_fftData);
-    // Average FFT output to smooth frequency resolution (Welch's method)
-    m_averager.addFrom(0, 0, m_averager.getReadPointer(m_averagerPtr), m_averager.getNumSamples(), -1.0f);
-    m_averager.copyFrom(m_averagerPtr, 0, m_fftData, m_averager.getNumSamples(), 1.0f / (m_averager.getNumSamples() * (m_averager.getNumChannels() - 1)));
-    m_averager.addFrom(0, 0, m_averager.getReadPointer(m_averagerPtr), m_averager.getNumSamples());
-    if (++m_averagerPtr == m_averager.getNumChannels())
-        m_averagerPtr = 1;
-    
-    const float* averagedData = m_averager.getReadPointer(0);
-
-    // Find the range of values produced, so we can scale our rendering to show up the detail clearly
-    m_fftLevelRange = FloatVectorOperations::findMinAndMax(averagedData, fftBins);
+    if (numFrames > 0)
+    {
+        m_latestFrame = numFrames - 1;
+    }
 
-    // Interpolate the latest averaged result
-    interpolateData(averagedData, m_visuData, InterpolationMode::Lanczos);
+    return numFrames;
+}
 
-    return true;
+Spectrogram::FrequencyInfo Spectrogram::getFrequencyInfo(int frame, int index) const
+{
+    jassert(frame >= 0 && frame < maxFramesPerUpdate);
+    const auto& spectralFrame = m_frames[frame];
+    const int levelIndex = getLevelIndex(spectralFrame, index);
+    return { spectralFrame.frequencies[levelIndex], spectralFrame.dbLevels[levelIndex], spectralFrame.normalizedLevels[levelIndex] };
 }
 
 Spectrogram::FrequencyInfo Spectrogram::getFrequencyInfo(int index) const
 {
-    const float frequency = m_frequencyAxis[index];
-    const float sample = m_visuData[index];
-    float leveldB = 0.0f;
-    float level = 0.0f;
+    return getFrequencyInfo(m_latestFrame, index);
+}
+
+void Spectrogram::getNormalizedLevels(int frame, float* normalizedLevels) const
+{
+    jassert(frame >= 0 && frame < maxFramesPerUpdate);
+    const auto& spectralFrame = m_frames[frame];
+
+    if (spectralFrame.numChannels == 1)
+    {
+        FloatVectorOperations::copy(normalizedLevels, spectralFrame.normalizedLevels.data(), m_resolution);
+        return;
+    }
+
+    for (int index = 0; index < m_resolution; ++index)
+    {
+        normalizedLevels[index] = spectralFrame.normalizedLevels[getLevelIndex(spectralFrame, index)];
+    }
+}
+
+int Spectrogram::getPartialPositions(int frame, int* positions) const
+{
+    jassert(frame >= 0 && frame < maxFramesPerUpdate);
+    const auto& spectralFrame = m_frames[frame];
+    const int channelHeight = m_resolution / spectralFrame.numChannels;
+    int numPositions = 0;
 
-    if (m_fftLevelRange.getEnd() != 0.0f)
+    for (int channel = 0; channel < spectralFrame.numChannels; ++channel)
     {
-        const float mindB = m_adaptativeLevel ? Decibels::gainToDecibels(m_fftLevelRange.getStart()) : -90.0f; // -100
-        const float maxdB = m_adaptativeLevel ? Decibels::gainToDecibels(m_fftLevelRange.getEnd()) : 10.0f;
-        if (mindB < maxdB)
+        const auto& partials = spectralFrame.partials[channel];
+        for (int track = 0; track < partials.numTracks; ++track)
         {
-            leveldB = Decibels::gainToDecibels(sample);
-            if (!m_adaptativeLevel && m_clipLevel && level > 0.0f)
-            {
-                leveldB = 0.0f;
-            }
-            level = jmap(jlimit(mindB, maxdB, leveldB), mindB, maxdB, 0.0f, 1.0f);
+            const int index = partials.rows[track];
+            if (index < 0)
+                continue;
+
+            // Inverse of getLevelIndex(): each channel gets an equal part of the axis
+            positions[numPositions++] = channel * channelHeight + index / spectralFrame.numChannels;
+        }
+    }
+
+    return numPositions;
+}
+
+int Spectrogram::getLoudestPartial(FrequencyInfo& loudestPartial) const
+{
+    const auto& spectralFrame = m_frames[m_latestFrame];
+    int numPartials = 0;
+    float loudestLevel = std::numeric_limits<float>::lowest();
+
+    for (int channel = 0; channel < spectralFrame.numChannels; ++channel)
+    {
+        // The tracks are sorted by decreasing level
+        const auto& partials = spectralFrame.partials[channel];
+        if (partials.numTracks > 0 && partials.levels[0] > loudestLevel)
+        {
+            loudestLevel = partials.levels[0];
+            loudestPartial.frequency = partials.frequencies[0];
+            loudestPartial.dbLevel = partials.levels[0];
         }
+
+        numPartials += partials.numTracks;
     }
 
-    return { frequency, leveldB, level };
+    return numPartials;
+}
+
+SpectralFeatures Spectrogram::getLatestFeatures() const
+{
+    SpectrumAnalyzer::FeatureSnapshot snapshot;
+    if (!m_analyzer.getFeatureHistory().readLatest(snapshot) || snapshot.numChannels == 0)
+        return {};
+
+    return snapshot.channels[0];
+}
+
+double Spectrogram::getAudioToScreenLatency() const
+{
+    const auto& spectralFrame = m_frames[m_latestFrame];
+    if (spectralFrame.endSample <= 0)
+        return 0.0;
+
+    const int64 pendingSamples = m_ringBuffer.getWritePosition() - spectralFrame.endSample;
+    const double sinceLastWrite = Time::getMillisecondCounterHiRes() - m_ringBuffer.getLastWriteTime();
+    return 1000.0 * pendingSamples / m_sampleRate + jmax(0.0, sinceLastWrite);
 }
 
 void Spectrogram::mouseEnter(const MouseEvent&)
@@ -134,79 +250,24 @@ void Spectrogram::mouseExit(const MouseEvent&)
     m_isMouseHover = false;
 }
 
-void Spectrogram::interpolateData(const float* inputData, float* outputData, InterpolationMode interpolationMode)
+int Spectrogram::getLevelIndex(const SpectralFrame& spectralFrame, int index) const
 {
-    FloatVectorOperations::clear(outputData, m_frequencyAxis.getResolution());
-
-    const int lanczosFilterSize = 5;
-    const float nyquistFrequency = static_cast<float>(m_sampleRate) / 2;
-    // Use frequency axis range instead of Nyquist frequency
-    const float freqToBin = (fftBins - 1) / nyquistFrequency;
-
-    /*for (size_t i = 0; i < fftBins; ++i)
-    {
-        inputData[i] = std::abs(inputData[i]);
-    }*/
+    if (spectralFrame.numChannels == 1)
+        return index;
 
-    double fftBinWidth = 1.0 / fftBins;
-    size_t x = 0;
+    // Multiple channels are laid out side by side (the first channel at the bottom).
+    // Each channel gets an equal part of the axis, so adjacent frequencies are merged by keeping the loudest one.
+    const int channelHeight = m_resolution / spectralFrame.numChannels;
+    const int channel = jmin(index / channelHeight, spectralFrame.numChannels - 1);
+    const int firstIndex = (index - channel * channelHeight) * spectralFrame.numChannels;
+    const int lastIndex = jmin(firstIndex + spectralFrame.numChannels, m_resolution) - 1;
 
-    // 1- Interpolate lower frequencies
-    switch (interpolationMode)
+    int loudestIndex = channel * m_resolution + firstIndex;
+    for (int i = channel * m_resolution + firstIndex + 1; i <= channel * m_resolution + lastIndex; ++i)
     {
-    case InterpolationMode::None:
-        for (x = 0; x < m_frequencyAxis.getResolution() - 1; ++x)
-        {
-            const double freqBinWidth = (m_frequencyAxis[x + 1] - m_frequencyAxis[x]) / nyquistFrequency;
-            if (freqBinWidth > fftBinWidth)
-                break;
-            // + 0.5 to centerly space bins
-            size_t index = jlimit(size_t(0), size_t(fftBins - 1), size_t(m_frequencyAxis[x] * freqToBin + 0.5));
-            outputData[x] = inputData[index];
-        }
-        break;
-    case InterpolationMode::Linear:
-        for (x = 0; x < m_frequencyAxis.getResolution() - 1; ++x)
-        {
-            const double freqBinWidth = (m_frequencyAxis[x + 1] - m_frequencyAxis[x]) / nyquistFrequency;
-            if (freqBinWidth > fftBinWidth)
-                break;
-            outputData[x] = linearFilter(inputData, fftBins, m_frequencyAxis[x] * freqToBin);
-        }
-        break;
-    case InterpolationMode::Lanczos:
-        for (x = 0; x < m_frequencyAxis.getResolution() - 1; ++x)
-        {
-            const double freqBinWidth = (m_frequencyAxis[x + 1] - m_frequencyAxis[x]) / nyquistFrequency;
-            if (freqBinWidth > fftBinWidth)
-                break;
-            outputData[x] = lanczosFilter(inputData, fftBins, m_frequencyAxis[x] * freqToBin, lanczosFilterSize);
-        }
-        break;
+        if (spectralFrame.dbLevels[i] > spectralFrame.dbLevels[loudestIndex])
+            loudestIndex = i;
     }
 
-    // 2- Filter out higher frequencies
-    int lastBin = static_cast<int>(m_frequencyAxis[x] * freqToBin);
-    for (; x < m_frequencyAxis.getResolution(); ++x)
-    {
-        const int currentBin = static_cast<int>(m_frequencyAxis[x] * freqToBin);
-
-        int maxBin = currentBin;
-        float maxBinLevel = std::numeric_limits<float>::lowest();
-
-        // Loop over all the bins that is mapped for a single coordinate
-        for (int nextBin = lastBin + 1; nextBin <= currentBin; ++nextBin)
-        {
-            const float nextBinLevel = inputData[nextBin];
-            // Select the one with the highest level for display
-            if (nextBinLevel > maxBinLevel)
-            {
-                maxBin = nextBin;
-                maxBinLevel = nextBinLevel;
-            }
-        }
-
-        outputData[x] = inputData[maxBin];
-        lastBin = currentBin;
-    }
+    return loudestIndex;
 }
\ No newline at end of file
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include "DSP/SpectrumAnalyzer.h"
 #include "GUI/OpenGLComponent.h"
 #include "Utilities/ColorMap.h"
 #include "Utilities/FrequencyAxis.h"
@@ -13,7 +14,8 @@
 class StatusBar;
 
 //--------------------------------------------------------------------------------------------
-/// Base spectrogram interface. Contains all the data and processing needed for visualization.
+/// Base spectrogram interface. Contains all the data needed for visualization.
+/// The processing is performed by a SpectrumAnalyzer on its own thread.
 /// Visualization and rendering must be performed in a derived class.
 //--------------------------------------------------------------------------------------------
 class Spectrogram : public OpenGLComponent
@@ -21,17 +23,31 @@ class Spectrogram : public OpenGLComponent
 public:
     //----------------------------------------------------------------------------------------
     /// Constructor.
+    /// @param[in] ringBuffer               Ring buffer that holds the incoming audio data (shared by every visualizer).
+    /// @param[in] ringReader               Index of the visualizer's reader in the ring buffer.
     /// @param[in] sampleRate               Sample rate.
     /// @param[in] outputResolution         Frequency output resolution.
     /// @param[out] statusBar               Reference to the status bar (GUI).
     //----------------------------------------------------------------------------------------
-    Spectrogram(double sampleRate, int outputResolution, StatusBar& statusBar);
+    Spectrogram(StereoRingBuffer& ringBuffer, int ringReader, double sampleRate, int outputResolution, StatusBar& statusBar);
 
     //----------------------------------------------------------------------------------------
     /// Destructor.
     //----------------------------------------------------------------------------------------
     virtual ~Spectrogram();
 
+    //----------------------------------------------------------------------------------------
+    /// Starts rendering and analysis.
+    /// @see OpenGLComponent::start.
+    //----------------------------------------------------------------------------------------
+    void start() noexcept override;
+
+    //----------------------------------------------------------------------------------------
+    /// Stops rendering and analysis.
+    /// @see OpenGLComponent::stop.
+    //----------------------------------------------------------------------------------------
+    void stop() noexcept override;
+
     //----------------------------------------------------------------------------------------
     /// Sets the maximum frequency of the spectrogram to better visualize the according range.
     /// @param[in] frequency                Maximum frequency.
@@ -51,6 +67,76 @@ public:
     //----------------------------------------------------------------------------------------
     void setClipLevel(bool enabled);
 
+    //----------------------------------------------------------------------------------------
+    /// Sets the hop size of the STFT (distance between two consecutive analysis frames).
+    /// Every available hop in the ring buffer is turned into a spectral frame, so the time resolution doesn't depend on the rendering rate.
+    /// @param[in] hopSize                  Hop size in samples. Gets clipped between fftSize / 16 and fftSize.
+    //----------------------------------------------------------------------------------------
+    void setHopSize(int hopSize);
+
+    //----------------------------------------------------------------------------------------
+    /// Sets the size of the FFT. Small sizes give a better time resolution and large sizes a better frequency resolution.
+    /// @param[in] order                    FFT order (size = 2 ^ order). Gets clipped between SpectrumAnalyzer::minFftOrder and SpectrumAnalyzer::maxFftOrder.
+    //----------------------------------------------------------------------------------------
+    void setFftOrder(int order);
+
+    //----------------------------------------------------------------------------------------
+    /// Sets which signal is analyzed. In dual mode, both channels are displayed side by side on the frequency axis.
+    /// @param[in] mode                     Channel mode.
+    //----------------------------------------------------------------------------------------
+    void setChannelMode(SpectrumAnalyzer::ChannelMode mode);
+
+    //----------------------------------------------------------------------------------------
+    /// Sets how the spectrum is mapped to the frequency axis (single FFT or constant-Q transform).
+    /// @param[in] mode                     Transform mode.
+    //----------------------------------------------------------------------------------------
+    void setTransformMode(SpectrumAnalyzer::TransformMode mode);
+
+    //----------------------------------------------------------------------------------------
+    /// Sets how the frequencies are distributed over the axis (linear, logarithmic or perceptual).
+    /// @param[in] distribution             Frequency distribution.
+    //----------------------------------------------------------------------------------------
+    void setFrequencyDistribution(FrequencyAxis<float>::Distribution distribution);
+
+    //----------------------------------------------------------------------------------------
+    /// Sets how consecutive spectral frames are averaged over time.
+    /// @param[in] settings                 Averaging parameters.
+    //----------------------------------------------------------------------------------------
+    void setAveraging(const SpectralAverager::Settings& settings);
+
+    //----------------------------------------------------------------------------------------
+    /// Sets the window applied to the frames before the FFT. The levels are corrected, so a sine reads the same level with every window.
+    /// @param[in] type                     Window type.
+    /// @param[in] kaiserBeta               Beta parameter of the Kaiser window.
+    //----------------------------------------------------------------------------------------
+    void setWindow(SpectrumAnalyzer::WindowType type, float kaiserBeta = SpectrumAnalyzer::defaultKaiserBeta);
+
+    //----------------------------------------------------------------------------------------
+    /// Sets the noise level correction on or off.
+    /// @param[in] enabled                  If true, the noise floor reads the same level with every window. If false, only sines do.
+    //----------------------------------------------------------------------------------------
+    void setNoiseLevelCorrection(bool enabled);
+
+    //----------------------------------------------------------------------------------------
+    /// Sets the partial tracking on or off. The tracked partials are drawn over the spectrogram and reported on the status bar.
+    /// @param[in] enabled                  If true, the peaks are linked into partial tracks. If false, no partial is tracked.
+    //----------------------------------------------------------------------------------------
+    void setPartialTracking(bool enabled);
+
+    //----------------------------------------------------------------------------------------
+    /// Sets how the analysis catches up when it falls behind the audio.
+    /// @param[in] policy                   Latency policy.
+    /// @param[in] maxFrames                Maximum number of pending hops analyzed at once (NewestFrames policy).
+    /// @param[in] timeBudget               Maximum duration of a batch of hops in milliseconds (TimeBudget policy).
+    //----------------------------------------------------------------------------------------
+    void setLatencyPolicy(SpectrumAnalyzer::LatencyPolicy policy, int maxFrames = SpectrumAnalyzer::defaultMaxPendingFrames,
+                          double timeBudget = SpectrumAnalyzer::defaultTimeBudget);
+
+    //----------------------------------------------------------------------------------------
+    /// Returns the spectral features of the latest analyzed frames. Can be read from any thread (GUI, host).
+    //----------------------------------------------------------------------------------------
+    const HistoryBuffer<SpectrumAnalyzer::FeatureSnapshot>& getFeatureHistory() const noexcept;
+
 protected:
     struct FrequencyInfo
     {
@@ -70,20 +156,63 @@ protected:
     virtual void createShaders() = 0;
 
     //----------------------------------------------------------------------------------------
-    /// Updates the data by performing an FFT on the current audio frame.
-    /// The FFT output is then getting averaged and interpolated for a smoother result.
+    /// Updates the data by retrieving the spectral frames finished by the analysis thread.
     /// This method should be called before each render.
-    /// @return								True if the data has been updated successfully.
+    /// @return								Number of new spectral frames (between 0 and maxFramesPerUpdate). The oldest one has index 0.
     //----------------------------------------------------------------------------------------
-    bool updateData();
+    int updateData();
 
     //----------------------------------------------------------------------------------------
     /// Returns the frequency and the according level (in normalized dB scale) at the specified index in the frequency axis.
+    /// @param[in] frame					Index of the spectral frame produced by the latest updateData() call.
+    /// @param[in] index					Position of the frequency on the axis.
+    /// @return								Frequency and level (in normalized dB scale).
+    //----------------------------------------------------------------------------------------
+    FrequencyInfo getFrequencyInfo(int frame, int index) const;
+
+    //----------------------------------------------------------------------------------------
+    /// Returns the frequency and the according level (in normalized dB scale) of the most recent spectral frame.
     /// @param[in] index					Position of the frequency on the axis.
     /// @return								Frequency and level (in normalized dB scale).
     //----------------------------------------------------------------------------------------
     FrequencyInfo getFrequencyInfo(int index) const;
 
+    //----------------------------------------------------------------------------------------
+    /// Copies the normalized levels of a whole spectral frame (one for each position on the frequency axis).
+    /// This is the batch equivalent of calling getFrequencyInfo() for every position, and should be preferred for rendering.
+    /// @param[in] frame					Index of the spectral frame produced by the latest updateData() call.
+    /// @param[out] normalizedLevels		Buffer in which to store the levels. Its size should be at least the resolution of the frequency axis.
+    //----------------------------------------------------------------------------------------
+    void getNormalizedLevels(int frame, float* normalizedLevels) const;
+
+    //----------------------------------------------------------------------------------------
+    /// Returns where the partials of a spectral frame are displayed on the frequency axis.
+    /// @param[in] frame					Index of the spectral frame produced by the latest updateData() call.
+    /// @param[out] positions				Buffer in which to store the positions. Its size should be at least maxChannels * PartialTracks::maxTracks.
+    /// @return								Number of positions (partials out of the axis range are skipped).
+    //----------------------------------------------------------------------------------------
+    int getPartialPositions(int frame, int* positions) const;
+
+    //----------------------------------------------------------------------------------------
+    /// Returns the loudest partial of the most recent spectral frame (all channels included).
+    /// @param[out] loudestPartial			Frequency and level (in dB) of the loudest partial. Left untouched if there is no partial.
+    /// @return								Number of partials in the frame.
+    //----------------------------------------------------------------------------------------
+    int getLoudestPartial(FrequencyInfo& loudestPartial) const;
+
+    //----------------------------------------------------------------------------------------
+    /// Returns the spectral features of the most recent analyzed frame (first channel).
+    /// @return								Features of the frame, or default features if no frame has been analyzed yet.
+    //----------------------------------------------------------------------------------------
+    SpectralFeatures getLatestFeatures() const;
+
+    //----------------------------------------------------------------------------------------
+    /// Returns the audio-to-screen latency: the age of the newest sample of the most recent frame.
+    /// It adds the samples written since that sample to the time elapsed since the last write.
+    /// @return								Latency in milliseconds, or 0 if no frame has been analyzed yet.
+    //----------------------------------------------------------------------------------------
+    double getAudioToScreenLatency() const;
+
     //----------------------------------------------------------------------------------------
     /// @see OpenGLComponent::render.
     //----------------------------------------------------------------------------------------
@@ -106,42 +235,31 @@ protected:
 
     enum
     {
-        fftOrder = 12,
-        fftSize = 1 << fftOrder, // 2 ^ fftOrder
-        fftBins = fftSize >> 1 // fftSize / 2
+        maxFramesPerUpdate = 32
     };
 
     StatusBar& m_statusBar;                 /// Reference to the status bar (GUI). The component should be updated in a derived class.
 
-    FrequencyAxis<float> m_frequencyAxis;	/// Frequency axis used for frequency data scaling.
+    SpectrumAnalyzer m_analyzer;			/// Analysis engine (runs on its own thread).
+    const int m_resolution;					/// Number of frequencies of the axis. The frequencies themselves come with each spectral frame.
     ColorMap m_colorMap;					/// Color map used for the normalized levels.
 
     std::atomic_bool m_isMouseHover = {};	/// If true, the mouse is inside the display frame. If false, the mouse is out of bounds.
     Point<int> m_mousePosition;				/// Current mouse position in local coordinates (relative to the bottom left corner).
+    HeapBlock<float> m_columnLevels;		/// Normalized levels of the spectral frame being rendered.
+    HeapBlock<int> m_partialPositions;		/// Positions of the partials of the spectral frame being rendered.
 
 private:
-    enum class InterpolationMode
-    {
-        None,
-        Linear,
-        Lanczos
-    };
-
-    void interpolateData(const float* inputData, float* outputData, InterpolationMode interpolationMode);
-
-    // Audio structures
-    dsp::FFT m_forwardFFT;					/// Forward Fourier transform function.
-    dsp::WindowingFunction<float> m_window;	/// Window function used to smooth spectral leakage.
-
-    HeapBlock<float, true> m_fftData;		/// Data used for FFT (as input and output).
-    HeapBlock<float, true> m_visuData;		/// Final output data used for visualisation.
-
-    AudioBuffer<float> m_averager;			/// Averaged FFT output (used for smoother frequency resolution).
-    int m_averagerPtr = 1;					/// Index used to keep track of the oldest averager slot.
+    //----------------------------------------------------------------------------------------
+    /// Returns where the level displayed at the specified position is stored in a spectral frame.
+    /// @param[in] spectralFrame			Spectral frame.
+    /// @param[in] index					Position of the frequency on the axis.
+    /// @return								Index of the level in the arrays of the spectral frame.
+    //----------------------------------------------------------------------------------------
+    int getLevelIndex(const SpectralFrame& spectralFrame, int index) const;
 
-    Range<float> m_fftLevelRange;		    /// Minimum and maximum levels of the latest FFT frame.
-    bool m_adaptativeLevel = false;	        /// If true, the level is normalized using min et max levels. If false, the original level is used for visualization.
-    bool m_clipLevel = false;               /// If true, the level is clipped to 0 dB. If false, the level is clipped to an arbitrary positive dB value.
+    std::vector<SpectralFrame> m_frames;	/// Spectral frames retrieved by the latest updateData() call.
+    int m_latestFrame = 0;					/// Index of the most recent spectral frame in m_frames.
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Spectrogram)
 };
\ No newline at end of file
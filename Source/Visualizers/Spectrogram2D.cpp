@@ -8,9 +8,9 @@
 #include "DSP/Filters.h"
 #include "GUI/StatusBar.h"
 
-Spectrogram2D::Spectrogram2D(double sampleRate, StatusBar& statusBar)
-    : Spectrogram(sampleRate, 512, statusBar)
-    , m_spectrogramImage(Image::RGB, m_frequencyAxis.getResolution(), m_frequencyAxis.getResolution(), false)
+Spectrogram2D::Spectrogram2D(StereoRingBuffer& ringBuffer, int ringReader, double sampleRate, StatusBar& statusBar)
+    : Spectrogram(ringBuffer, ringReader, sampleRate, 512, statusBar)
+    , m_spectrogramImage(Image::RGB, m_resolution, m_resolution, false)
 {
     m_backgroundColor = Colour::fromRGB(25, 25, 25);
 }
@@ -81,34 +81,67 @@ void Spectrogram2D::createShaders()
 
 void Spectrogram2D::render()
 {
-    updateData();
+    const int width = m_spectrogramImage.getWidth();
+    const int numFrames = jmin(updateData(), width);
 
-    const int rightHandEdge = m_spectrogramImage.getWidth() - 1;
-    m_spectrogramImage.moveImageSection(0, 0, 1, 0, rightHandEdge, m_spectrogramImage.getHeight());
-
-    // Calculate new y values and shift old y values back
-    for (int y = 0; y < m_frequencyAxis.getResolution(); ++y)
+    if (numFrames > 0)
     {
-        const int j = m_frequencyAxis.getResolution() - y - 1;
-        const auto frequencyInfo = getFrequencyInfo(y);
-        const auto color = m_colorMap.getColorAtPosition(frequencyInfo.normalizedLevel);
-        const auto texelValue = Colour::fromFloatRGBA(color.x, color.y, color.z, 1.0f);
-        m_spectrogramImage.setPixelAt(rightHandEdge, j, texelValue);
+        // Shift old columns back to make room for the new spectral frames
+        m_spectrogramImage.moveImageSection(0, 0, numFrames, 0, width - numFrames, m_spectrogramImage.getHeight());
+
+        for (int frame = 0; frame < numFrames; ++frame)
+        {
+            const int x = width - numFrames + frame;
+            getNormalizedLevels(frame, m_columnLevels);
+
+            // Calculate new y values
+            for (int y = 0; y < m_resolution; ++y)
+            {
+                const int j = m_resolution - y - 1;
+                const auto color = m_colorMap.getColorAtPosition(m_columnLevels[y]);
+                const auto texelValue = Colour::fromFloatRGBA(color.x, color.y, color.z, 1.0f);
+                m_spectrogramImage.setPixelAt(x, j, texelValue);
+            }
+
+            // Partial tracks are drawn over the levels
+            const int numPartials = getPartialPositions(frame, m_partialPositions);
+            for (int i = 0; i < numPartials; ++i)
+            {
+                const int j = m_resolution - m_partialPositions[i] - 1;
+                m_spectrogramImage.setPixelAt(x, j, Colours::white);
+            }
+        }
     }
 
+    FrequencyInfo loudestPartial;
+    const auto features = getLatestFeatures();
+
+    StatusBar::StatusInfo status;
+    status.fps = m_fps;
+    status.numPartials = getLoudestPartial(loudestPartial);
+    status.partialFrequency = loudestPartial.frequency;
+    status.centroid = features.centroid;
+    status.flatness = features.flatness;
+    status.numDropped = m_ringBuffer.getNumDropped();
+    status.numOverwritten = m_ringBuffer.getNumOverwritten();
+    status.latency = getAudioToScreenLatency();
+
     if (m_isMouseHover)
     {
-        jassert(m_mousePosition.y < m_frequencyAxis.getResolution());
+        jassert(m_mousePosition.y < m_resolution);
         const auto hoveredFrequencyInfo = getFrequencyInfo(m_mousePosition.y);
-        m_statusBar.update(m_fps, hoveredFrequencyInfo.frequency, hoveredFrequencyInfo.dbLevel);
+        status.frequency = hoveredFrequencyInfo.frequency;
+        status.level = hoveredFrequencyInfo.dbLevel;
     }
-    else
+
+    m_statusBar.update(status);
+    
+    // Only upload the image when it has changed
+    if (numFrames > 0 || m_spectrogramTexture.getTextureID() == 0)
     {
-        m_statusBar.update(m_fps, 0.0f, 0.0f);
+        m_spectrogramTexture.loadImage(m_spectrogramImage);
     }
     
-    m_spectrogramTexture.loadImage(m_spectrogramImage);
-    
     // GL_TEXTURE0 is activated by default
     m_spectrogramTexture.bind();
     m_openGLContext.extensions.glBindVertexArray(m_VAO);
@@ -17,10 +17,12 @@ class Spectrogram2D : public Spectrogram
 public:
     //----------------------------------------------------------------------------------------
     /// Constructor.
+    /// @param[in] ringBuffer               Ring buffer that holds the incoming audio data (shared by every visualizer).
+    /// @param[in] ringReader               Index of the visualizer's reader in the ring buffer.
     /// @param[in] sampleRate               Sample rate.
     /// @param[out] statusBar               Reference to the status bar (GUI).
     //----------------------------------------------------------------------------------------
-    Spectrogram2D(double sampleRate, StatusBar& statusBar);
+    Spectrogram2D(StereoRingBuffer& ringBuffer, int ringReader, double sampleRate, StatusBar& statusBar);
 
     //----------------------------------------------------------------------------------------
     /// Destructor.
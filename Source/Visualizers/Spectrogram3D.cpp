@@ -8,9 +8,9 @@
 #include "DSP/Filters.h"
 #include "GUI/StatusBar.h"
 
-Spectrogram3D::Spectrogram3D(double sampleRate, StatusBar& statusBar)
-    : Spectrogram(sampleRate, 512, statusBar)
-    , m_spectrogramImage(Image::ARGB, m_frequencyAxis.getResolution() / 2, m_frequencyAxis.getResolution(), false)
+Spectrogram3D::Spectrogram3D(StereoRingBuffer& ringBuffer, int ringReader, double sampleRate, StatusBar& statusBar)
+    : Spectrogram(ringBuffer, ringReader, sampleRate, 512, statusBar)
+    , m_spectrogramImage(Image::ARGB, m_resolution / 2, m_resolution, false)
     , m_draggableOrientation(11.0f)
 {
     m_backgroundColor = Colour::fromRGB(25, 25, 25);
@@ -30,7 +30,7 @@ void Spectrogram3D::initialise()
     m_zTimeDepth = 3.0f;
 
     // Time resolution = frequency resolution
-    m_zTimeResolution = static_cast<GLuint>(m_frequencyAxis.getResolution());
+    m_zTimeResolution = static_cast<GLuint>(m_resolution);
 
     // Generate data
     initializeVertices();
@@ -105,25 +105,59 @@ void Spectrogram3D::createShaders()
 
 void Spectrogram3D::render()
 {
-    updateData();
+    const int width = m_spectrogramImage.getWidth();
+    const int numFrames = jmin(updateData(), width);
 
-    const int rightHandEdge = m_spectrogramImage.getWidth() - 1;
-    m_spectrogramImage.moveImageSection(0, 0, 1, 0, rightHandEdge, m_spectrogramImage.getHeight());
-
-    // Calculate new y values and shift old y values back
-    for (int y = 0; y < m_frequencyAxis.getResolution(); ++y)
+    if (numFrames > 0)
     {
-        const int j = m_frequencyAxis.getResolution() - y - 1;
-        const auto frequencyInfo = getFrequencyInfo(y);
-        const auto color = m_colorMap.getColorAtPosition(frequencyInfo.normalizedLevel);
-        // Alpha channel is used for height. If the level exceeds 1.0, it gets clipped
-        const auto texelValue = Colour::fromFloatRGBA(color.x, color.y, color.z, frequencyInfo.normalizedLevel);
-        m_spectrogramImage.setPixelAt(rightHandEdge, j, texelValue);
-    }
+        // Shift old columns back to make room for the new spectral frames
+        m_spectrogramImage.moveImageSection(0, 0, numFrames, 0, width - numFrames, m_spectrogramImage.getHeight());
 
-    m_statusBar.update(m_fps, 0.0f, 0.0f);
+        for (int frame = 0; frame < numFrames; ++frame)
+        {
+            const int x = width - numFrames + frame;
+            getNormalizedLevels(frame, m_columnLevels);
+
+            // Calculate new y values
+            for (int y = 0; y < m_resolution; ++y)
+            {
+                const int j = m_resolution - y - 1;
+                const auto color = m_colorMap.getColorAtPosition(m_columnLevels[y]);
+                // Alpha channel is used for height. If the level exceeds 1.0, it gets clipped
+                const auto texelValue = Colour::fromFloatRGBA(color.x, color.y, color.z, m_columnLevels[y]);
+                m_spectrogramImage.setPixelAt(x, j, texelValue);
+            }
+
+            // Partial tracks are drawn over the levels, without changing the height of the surface
+            const int numPartials = getPartialPositions(frame, m_partialPositions);
+            for (int i = 0; i < numPartials; ++i)
+            {
+                const int y = m_partialPositions[i];
+                const int j = m_resolution - y - 1;
+                m_spectrogramImage.setPixelAt(x, j, Colours::white.withAlpha(m_columnLevels[y]));
+            }
+        }
+    }
 
-    m_spectrogramTexture.loadImage(m_spectrogramImage);
+    FrequencyInfo loudestPartial;
+    const auto features = getLatestFeatures();
+
+    StatusBar::StatusInfo status;
+    status.fps = m_fps;
+    status.numPartials = getLoudestPartial(loudestPartial);
+    status.partialFrequency = loudestPartial.frequency;
+    status.centroid = features.centroid;
+    status.flatness = features.flatness;
+    status.numDropped = m_ringBuffer.getNumDropped();
+    status.numOverwritten = m_ringBuffer.getNumOverwritten();
+    status.latency = getAudioToScreenLatency();
+    m_statusBar.update(status);
+
+    // Only upload the image when it has changed
+    if (numFrames > 0 || m_spectrogramTexture.getTextureID() == 0)
+    {
+        m_spectrogramTexture.loadImage(m_spectrogramImage);
+    }
 
     Matrix3D<float> scale;
     scale.mat[0] = 2.0f;
@@ -159,10 +193,10 @@ void Spectrogram3D::mouseDrag(const MouseEvent& e)
 
 void Spectrogram3D::initializeVertices()
 {
-    const GLuint xFreqResolution = static_cast<GLuint>(m_frequencyAxis.getResolution());
+    const GLuint xFreqResolution = static_cast<GLuint>(m_resolution);
     m_vertices.reserve((xFreqResolution + 2) * (m_zTimeResolution + 2));
 
-    const GLfloat xOffset = m_xFreqWidth / m_frequencyAxis.getResolution();
+    const GLfloat xOffset = m_xFreqWidth / m_resolution;
     const GLfloat zOffset = m_zTimeDepth / m_zTimeResolution;
     const GLfloat xStart = +(m_xFreqWidth / 2.0f);
     const GLfloat zStart = -(m_zTimeDepth / 2.0f);
@@ -201,7 +235,7 @@ void Spectrogram3D::initializeVertices()
 
 void Spectrogram3D::initializeIndices()
 {
-    const GLuint xFreqResolution = static_cast<GLuint>(m_frequencyAxis.getResolution()) + 2;
+    const GLuint xFreqResolution = static_cast<GLuint>(m_resolution) + 2;
     const GLuint zTimeResolution = m_zTimeResolution + 2;
     m_indices.reserve(6 * (xFreqResolution - 1) * (zTimeResolution - 1));
     